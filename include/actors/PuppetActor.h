@@ -20,12 +20,34 @@
 
 #include "logger.hpp"
 #include "puppets/PuppetInfo.h"
-#include "puppets/HackModelHolder.hpp"
 #include "helpers.hpp"
 #include "algorithms/CaptureTypes.h"
+#include "algorithms/PlayerAnims.h"
+#include "algorithms/CostumeTypes.h"
 
 #include "server/freeze/FreezePlayerBlock.h"
 
+// how much of PuppetActor::control runs for a puppet, picked each frame from its camera distance and clipping
+enum class PuppetLod : u8 {
+    Full,     // everything, every frame
+    Reduced,  // far away: no blend weights, model pose synced every other frame
+    Minimal   // very far or clipped: no blend weights, model pose synced every fourth frame
+};
+
+// sub actors of a puppet's current model, looked up by name once whenever the current model changes
+struct PuppetModelParts {
+    static constexpr int cSubActorCount = 5;  // face, eyes, head, left hand, right hand
+    static constexpr int cFaceIndex = 0;
+    static constexpr int cHeadIndex = 2;
+
+    al::LiveActor* model = nullptr;
+    al::LiveActor* subActors[cSubActorCount] = {};
+    al::LiveActor* hair = nullptr;
+
+    al::LiveActor* getFace() const { return subActors[cFaceIndex]; }
+    al::LiveActor* getHead() const { return subActors[cHeadIndex]; }
+};
+
 class PuppetActor : public al::LiveActor {
     public:
         PuppetActor(const char *name);
@@ -49,25 +71,22 @@ class PuppetActor : public al::LiveActor {
         void initOnline(PuppetInfo *pupInfo);
 
         void startAction(const char *actName);
+        void startAction(PlayerAnims::Type type, const char *actName);
         void hairControl();
 
         void setBlendWeight(int index, float weight) { al::setSklAnimBlendWeight(getCurrentModel(), weight, index); };
 
         bool isNeedBlending();
 
-        bool isInCaptureList(const char *hackName);
-
         PuppetInfo* getInfo() { return mInfo; }
 
-        bool addCapture(PuppetHackActor *capture, const char *hackType);
-
-        al::LiveActor* getCurrentModel();
+        // index of this puppet in PuppetHolder, -1 for the debug puppet
+        int getPuppetIndex() const { return mPuppetIndex; }
+        void setPuppetIndex(int index) { mPuppetIndex = index; }
 
-        int getMaxCaptures() {return mCaptures->getEntryCount(); };
+        PuppetLod getLod() const { return mLod; }
 
-        void debugTeleportCaptures(const sead::Vector3f& pos);
-
-        void debugTeleportCapture(const sead::Vector3f& pos, int index);
+        al::LiveActor* getCurrentModel();
 
         void emitJoinEffect();
 
@@ -80,13 +99,23 @@ class PuppetActor : public al::LiveActor {
 
         bool setCapture(const char* captureName);
 
+        void releaseCapture();
+
         void syncPose();
 
+        PuppetLod calcLod(al::LiveActor* curModel) const;
+
+        bool isAnimStarted(const al::LiveActor* model, PlayerAnims::Type type) const;
+
+        const PuppetModelParts& getModelParts();
+
+        bool isLodUpdateFrame() const;
+
         PlayerCostumeInfo *mCostumeInfo = nullptr;
         PuppetInfo *mInfo = nullptr;
         PuppetCapActor *mPuppetCap = nullptr;
         PlayerModelHolder *mModelHolder = nullptr;
-        HackModelHolder* mCaptures = nullptr;
+        PuppetHackActor* mCaptureActor = nullptr;  // leased from CaptureActorPool while captured
         NameTag *mNameTag = nullptr;
 
         CaptureTypes::Type mCurCapture = CaptureTypes::Type::Unknown;
@@ -97,10 +126,25 @@ class PuppetActor : public al::LiveActor {
 
         float mClosingSpeed = 0;
 
+        int mPuppetIndex = -1;
+
+        PuppetLod mLod = PuppetLod::Full;
+
+        PuppetModelParts mModelParts;
+
+        // action last started on mAnimModel, so control only goes through the name based action calls when it changes
+        al::LiveActor* mAnimModel = nullptr;
+        PlayerAnims::Type mStartedAnim = PlayerAnims::Type::Unknown;
+
+        // "%sFullFace" name for mFaceAnim, formatted once per animation instead of on every start
+        PlayerAnims::Type mFaceAnim = PlayerAnims::Type::Unknown;
+        sead::FixedSafeString<0x80> mFaceAnimName;
+
         FreezePlayerBlock* mFreezeTagIceBlock = nullptr;
 };
 
 PlayerCostumeInfo* initMarioModelPuppet(al::LiveActor* player, const al::ActorInitInfo& initInfo,
-                                        char const* bodyName, char const* capName, int subActorNum,
-                                        al::AudioKeeper* audioKeeper);
+                                        char const* bodyName, char const* capName,
+                                        CostumeTypes::Type bodyType, CostumeTypes::Type capType,
+                                        int subActorNum, al::AudioKeeper* audioKeeper);
 PlayerHeadCostumeInfo* initMarioHeadCostumeInfo(al::LiveActor* player, const al::ActorInitInfo &initInfo, const char* headModelName, const char* capModelName, const char* headType, const char* headSuffix);
\ No newline at end of file
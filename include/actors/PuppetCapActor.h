@@ -10,6 +10,7 @@
 #include "logger.hpp"
 #include "puppets/PuppetInfo.h"
 #include "helpers.hpp"
+#include "algorithms/CapAnims.h"
 
 class PuppetCapActor : public al::LiveActor {
     public:
@@ -24,10 +25,13 @@ class PuppetCapActor : public al::LiveActor {
         
         void initOnline(PuppetInfo *info);
         
-        void startAction(const char *actName);
+        void startAction(CapAnims::Type anim);
         void update();
 
     private:
         HackCapJointControlKeeper *mJointKeeper;
         PuppetInfo *mInfo;
+
+        CapAnims::Type mCurAnim = CapAnims::Type::Unknown;
+        bool mIsAnimMissing[CapAnims::ToValue(CapAnims::Type::End)] = {}; // actions the cap model failed to start, so we dont retry them every frame
 };
@@ -18,11 +18,14 @@ class PuppetHackActor : public al::LiveActor {
         virtual void movement(void) override;
         void initOnline(PuppetInfo *info, const char *hackType);
 
+        // pooled actors are pointed at the puppet they're leased to
+        void setPuppetInfo(PuppetInfo *info) { mInfo = info; }
+
         void startAction(const char* actName);
 
         void startHackAnim(bool isOn);
         
     private:
-        PuppetInfo *mInfo;
+        PuppetInfo *mInfo = nullptr;
         sead::FixedSafeString<0x20> mHackType;
 };
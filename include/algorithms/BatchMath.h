@@ -0,0 +1,215 @@
+#pragma once
+
+#include <math.h>
+#include "basis/seadTypes.h"
+#include "math/seadVector.h"
+
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+// math kernels that run over structure of arrays data (separate x/y/z arrays) instead of one sead::Vector3f at a
+// time, so the switch build can do four puppets per NEON instruction. the scalar fallback is used on other targets.
+// output arrays may alias the matching input arrays.
+namespace batch {
+
+    // sphere vs frustum plane, the normal points into the frustum so points inside have a positive distance
+    struct Plane {
+        float x, y, z, d;
+    };
+
+    constexpr int cFrustumPlaneCount = 6;
+
+    // out[i] = squared distance from (x[i], y[i], z[i]) to target
+    inline void calcDistanceSq(float* out, const float* x, const float* y, const float* z,
+                               const sead::Vector3f& target, int count) {
+        int i = 0;
+
+#ifdef __ARM_NEON
+        float32x4_t tx = vdupq_n_f32(target.x);
+        float32x4_t ty = vdupq_n_f32(target.y);
+        float32x4_t tz = vdupq_n_f32(target.z);
+
+        for (; i + 4 <= count; i += 4) {
+            float32x4_t dx = vsubq_f32(vld1q_f32(x + i), tx);
+            float32x4_t dy = vsubq_f32(vld1q_f32(y + i), ty);
+            float32x4_t dz = vsubq_f32(vld1q_f32(z + i), tz);
+
+            float32x4_t distSq = vmulq_f32(dx, dx);
+            distSq = vfmaq_f32(distSq, dy, dy);
+            distSq = vfmaq_f32(distSq, dz, dz);
+
+            vst1q_f32(out + i, distSq);
+        }
+#endif
+
+        for (; i < count; i++) {
+            float dx = x[i] - target.x;
+            float dy = y[i] - target.y;
+            float dz = z[i] - target.z;
+            out[i] = dx * dx + dy * dy + dz * dz;
+        }
+    }
+
+    inline void calcSqrt(float* out, const float* in, int count) {
+        int i = 0;
+
+#ifdef __ARM_NEON
+        for (; i + 4 <= count; i += 4) {
+            vst1q_f32(out + i, vsqrtq_f32(vld1q_f32(in + i)));
+        }
+#endif
+
+        for (; i < count; i++) {
+            out[i] = sqrtf(in[i]);
+        }
+    }
+
+    // moves each position rate of the way towards its target, same as al::lerpVec
+    inline void lerp(float* x, float* y, float* z, const float* targetX, const float* targetY, const float* targetZ,
+                     float rate, int count) {
+        int i = 0;
+
+#ifdef __ARM_NEON
+        float32x4_t r = vdupq_n_f32(rate);
+
+        for (; i + 4 <= count; i += 4) {
+            float32x4_t vx = vld1q_f32(x + i);
+            float32x4_t vy = vld1q_f32(y + i);
+            float32x4_t vz = vld1q_f32(z + i);
+
+            vst1q_f32(x + i, vfmaq_f32(vx, vsubq_f32(vld1q_f32(targetX + i), vx), r));
+            vst1q_f32(y + i, vfmaq_f32(vy, vsubq_f32(vld1q_f32(targetY + i), vy), r));
+            vst1q_f32(z + i, vfmaq_f32(vz, vsubq_f32(vld1q_f32(targetZ + i), vz), r));
+        }
+#endif
+
+        for (; i < count; i++) {
+            x[i] += (targetX[i] - x[i]) * rate;
+            y[i] += (targetY[i] - y[i]) * rate;
+            z[i] += (targetZ[i] - z[i]) * rate;
+        }
+    }
+
+    // spherical interpolation of unit quaternions towards their targets, taking the shortest path. the dot products
+    // and blending are vectorized, the acos/sin for the blend weights are done per quaternion.
+    inline void slerp(float* qx, float* qy, float* qz, float* qw, const float* targetX, const float* targetY,
+                      const float* targetZ, const float* targetW, float rate, int count) {
+        constexpr int cChunkSize = 16;
+
+        for (int start = 0; start < count; start += cChunkSize) {
+            int chunkCount = count - start < cChunkSize ? count - start : cChunkSize;
+
+            float* x = qx + start;
+            float* y = qy + start;
+            float* z = qz + start;
+            float* w = qw + start;
+            const float* tx = targetX + start;
+            const float* ty = targetY + start;
+            const float* tz = targetZ + start;
+            const float* tw = targetW + start;
+
+            float fromWeight[cChunkSize];
+            float toWeight[cChunkSize];
+
+            // dot products
+            int i = 0;
+#ifdef __ARM_NEON
+            for (; i + 4 <= chunkCount; i += 4) {
+                float32x4_t dot = vmulq_f32(vld1q_f32(x + i), vld1q_f32(tx + i));
+                dot = vfmaq_f32(dot, vld1q_f32(y + i), vld1q_f32(ty + i));
+                dot = vfmaq_f32(dot, vld1q_f32(z + i), vld1q_f32(tz + i));
+                dot = vfmaq_f32(dot, vld1q_f32(w + i), vld1q_f32(tw + i));
+                vst1q_f32(fromWeight + i, dot);
+            }
+#endif
+            for (; i < chunkCount; i++) {
+                fromWeight[i] = x[i] * tx[i] + y[i] * ty[i] + z[i] * tz[i] + w[i] * tw[i];
+            }
+
+            // blend weights, flipping the target when it's on the far side and falling back to a plain lerp when
+            // the quaternions are close enough that sin(theta) loses precision
+            for (i = 0; i < chunkCount; i++) {
+                float dot = fromWeight[i];
+                float sign = dot < 0.f ? -1.f : 1.f;
+                dot *= sign;
+
+                if (dot > 0.9995f) {
+                    fromWeight[i] = 1.f - rate;
+                    toWeight[i] = rate * sign;
+                } else {
+                    float theta = acosf(dot);
+                    float invSin = 1.f / sinf(theta);
+                    fromWeight[i] = sinf((1.f - rate) * theta) * invSin;
+                    toWeight[i] = sinf(rate * theta) * invSin * sign;
+                }
+            }
+
+            // blend
+            i = 0;
+#ifdef __ARM_NEON
+            for (; i + 4 <= chunkCount; i += 4) {
+                float32x4_t from = vld1q_f32(fromWeight + i);
+                float32x4_t to = vld1q_f32(toWeight + i);
+
+                vst1q_f32(x + i, vfmaq_f32(vmulq_f32(vld1q_f32(x + i), from), vld1q_f32(tx + i), to));
+                vst1q_f32(y + i, vfmaq_f32(vmulq_f32(vld1q_f32(y + i), from), vld1q_f32(ty + i), to));
+                vst1q_f32(z + i, vfmaq_f32(vmulq_f32(vld1q_f32(z + i), from), vld1q_f32(tz + i), to));
+                vst1q_f32(w + i, vfmaq_f32(vmulq_f32(vld1q_f32(w + i), from), vld1q_f32(tw + i), to));
+            }
+#endif
+            for (; i < chunkCount; i++) {
+                x[i] = x[i] * fromWeight[i] + tx[i] * toWeight[i];
+                y[i] = y[i] * fromWeight[i] + ty[i] * toWeight[i];
+                z[i] = z[i] * fromWeight[i] + tz[i] * toWeight[i];
+                w[i] = w[i] * fromWeight[i] + tw[i] * toWeight[i];
+            }
+        }
+    }
+
+    // out[i] = true if the sphere at (x[i], y[i], z[i]) with the given radius touches the frustum
+    inline void isInFrustum(bool* out, const float* x, const float* y, const float* z, float radius,
+                            const Plane (&planes)[cFrustumPlaneCount], int count) {
+        int i = 0;
+
+#ifdef __ARM_NEON
+        float32x4_t negRadius = vdupq_n_f32(-radius);
+
+        for (; i + 4 <= count; i += 4) {
+            float32x4_t vx = vld1q_f32(x + i);
+            float32x4_t vy = vld1q_f32(y + i);
+            float32x4_t vz = vld1q_f32(z + i);
+
+            uint32x4_t inside = vdupq_n_u32(0xFFFFFFFF);
+
+            for (int p = 0; p < cFrustumPlaneCount; p++) {
+                const Plane& plane = planes[p];
+
+                float32x4_t dist = vdupq_n_f32(plane.d);
+                dist = vfmaq_n_f32(dist, vx, plane.x);
+                dist = vfmaq_n_f32(dist, vy, plane.y);
+                dist = vfmaq_n_f32(dist, vz, plane.z);
+
+                inside = vandq_u32(inside, vcgeq_f32(dist, negRadius));
+            }
+
+            out[i] = vgetq_lane_u32(inside, 0) != 0;
+            out[i + 1] = vgetq_lane_u32(inside, 1) != 0;
+            out[i + 2] = vgetq_lane_u32(inside, 2) != 0;
+            out[i + 3] = vgetq_lane_u32(inside, 3) != 0;
+        }
+#endif
+
+        for (; i < count; i++) {
+            bool inside = true;
+
+            for (int p = 0; p < cFrustumPlaneCount; p++) {
+                const Plane& plane = planes[p];
+                inside &= plane.x * x[i] + plane.y * y[i] + plane.z * z[i] + plane.d >= -radius;
+            }
+
+            out[i] = inside;
+        }
+    }
+
+}  // namespace batch
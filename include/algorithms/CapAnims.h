@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include "crc32.h"
+#include "basis/seadTypes.h"
+
+namespace CapAnims {
+
+    enum class Type : s16 {
+        Unknown = -1,
+        // Idle
+        Default,
+        Wait,
+        Stay,
+        StayL,
+        StayR,
+        // Throws
+        Throw,
+        ThrowL,
+        ThrowR,
+        ThrowSpin,
+        ThrowSpinL,
+        ThrowSpinR,
+        ThrowUpper,
+        ThrowDown,
+        ThrowRolling,
+        ThrowRollingL,
+        ThrowRollingR,
+        ThrowTornado,
+        // Flight
+        Fly,
+        FlyL,
+        FlyR,
+        Spin,
+        SpinL,
+        SpinR,
+        Rolling,
+        RollingL,
+        RollingR,
+        // Return & Reactions
+        Return,
+        ReturnStart,
+        Catch,
+        Blow,
+        Reflect,
+        Trample,
+        HipDrop,
+        // Capture
+        HackStart,
+        Hack,
+        End
+    };
+
+    static constexpr size_t ToValue(Type type) { return static_cast<std::uint16_t>(type); }
+
+    static constexpr Type ToType(std::uint16_t value) {return static_cast<Type>(value);}
+
+    static constexpr std::array<const char*, ToValue(Type::End)> s_Strs {
+        // Idle
+        "Default", "Wait", "Stay", "StayL", "StayR",
+        // Throws
+        "Throw", "ThrowL", "ThrowR", "ThrowSpin", "ThrowSpinL", "ThrowSpinR", "ThrowUpper",
+        "ThrowDown", "ThrowRolling", "ThrowRollingL", "ThrowRollingR", "ThrowTornado",
+        // Flight
+        "Fly", "FlyL", "FlyR", "Spin", "SpinL", "SpinR", "Rolling", "RollingL", "RollingR",
+        // Return & Reactions
+        "Return", "ReturnStart", "Catch", "Blow", "Reflect", "Trample", "HipDrop",
+        // Capture
+        "HackStart", "Hack"
+    };
+
+    // these ifdefs are really dumb but it makes clangd happy so /shrug
+#ifndef ANALYZER
+    static constexpr crc32::HashArray s_Hashes(s_Strs);
+#endif
+
+    static constexpr Type FindType(std::string_view const& str) {
+#ifndef ANALYZER
+        return ToType(s_Hashes.FindIndex(str));
+#else
+        return Type::Unknown;
+#endif
+    }
+
+    static constexpr const char *FindStr(Type type) {
+        const s16 type_ = (s16)type;
+        if (0 <= type_ && (size_t)type_ < s_Strs.size())
+            return s_Strs[type_];
+        else
+            return "";
+    }
+}
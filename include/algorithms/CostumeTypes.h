@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include "crc32.h"
+#include "basis/seadTypes.h"
+
+namespace CostumeTypes {
+
+    enum class Type : s16 {
+        Unknown = -1,
+        Mario,
+        Mario64,
+        Mario64Metal,
+        MarioAloha,
+        MarioArmor,
+        MarioBone,
+        MarioClown,
+        MarioColorClassic,
+        MarioColorGold,
+        MarioColorLuigi,
+        MarioColorWaluigi,
+        MarioColorWario,
+        MarioCook,
+        MarioDiddyKong,
+        MarioDoctor,
+        MarioExplorer,
+        MarioFootball,
+        MarioGolf,
+        MarioGunman,
+        MarioHakama,
+        MarioHappi,
+        MarioKing,
+        MarioKoopa,
+        MarioMaker,
+        MarioMechanic,
+        MarioNew3DS,
+        MarioPainter,
+        MarioPeach,
+        MarioPilot,
+        MarioPirate,
+        MarioPoncho,
+        MarioPrimitiveMan,
+        MarioSailor,
+        MarioScientist,
+        MarioShopman,
+        MarioSnowSuit,
+        MarioSpaceSuit,
+        MarioSuit,
+        MarioSwimwear,
+        MarioTailCoat,
+        MarioTuxedo,
+        MarioUnderwear,
+        End
+    };
+
+    static constexpr size_t ToValue(Type type) { return static_cast<std::uint16_t>(type); }
+
+    static constexpr Type ToType(std::uint16_t value) {return static_cast<Type>(value);}
+
+    static constexpr std::array<const char*, ToValue(Type::End)> s_Strs {
+        "Mario", "Mario64", "Mario64Metal", "MarioAloha", "MarioArmor", "MarioBone", "MarioClown",
+        "MarioColorClassic", "MarioColorGold", "MarioColorLuigi", "MarioColorWaluigi",
+        "MarioColorWario", "MarioCook", "MarioDiddyKong", "MarioDoctor", "MarioExplorer",
+        "MarioFootball", "MarioGolf", "MarioGunman", "MarioHakama", "MarioHappi", "MarioKing",
+        "MarioKoopa", "MarioMaker", "MarioMechanic", "MarioNew3DS", "MarioPainter", "MarioPeach",
+        "MarioPilot", "MarioPirate", "MarioPoncho", "MarioPrimitiveMan", "MarioSailor",
+        "MarioScientist", "MarioShopman", "MarioSnowSuit", "MarioSpaceSuit", "MarioSuit",
+        "MarioSwimwear", "MarioTailCoat", "MarioTuxedo", "MarioUnderwear"
+    };
+
+    // model setup info derived from each costume name, used to pick head models without any string compares
+    struct ModelInfo {
+        bool isMario64Cap = false;    // caps named Mario64* use a dedicated head model
+        bool isShortHeadCap = false;  // caps that use the short head variant on bodies that support it
+        const char* head64Type = "";  // head type suffix used when this body is paired with a Mario64 cap
+    };
+
+    static constexpr std::array<ModelInfo, ToValue(Type::End)> CreateModelInfos() {
+        std::array<ModelInfo, ToValue(Type::End)> infos {};
+
+        for (size_t i = 0; i < infos.size(); i++) {
+            std::string_view name = s_Strs[i];
+
+            infos[i].isMario64Cap = name.find("Mario64") != std::string_view::npos;
+            infos[i].isShortHeadCap = name == "MarioPeach";
+
+            if (name == "Mario64")
+                infos[i].head64Type = "";
+            else if (name == "Mario64Metal")
+                infos[i].head64Type = "Metal";
+            else
+                infos[i].head64Type = "Other";
+        }
+
+        return infos;
+    }
+
+    static constexpr std::array<ModelInfo, ToValue(Type::End)> s_ModelInfos = CreateModelInfos();
+
+    // these ifdefs are really dumb but it makes clangd happy so /shrug
+#ifndef ANALYZER
+    static constexpr crc32::HashArray s_Hashes(s_Strs);
+#endif
+
+    static constexpr Type FindType(std::string_view const& str) {
+#ifndef ANALYZER
+        return ToType(s_Hashes.FindIndex(str));
+#else
+        return Type::Unknown;
+#endif
+    }
+
+    static constexpr const char *FindStr(Type type) {
+        const s16 type_ = (s16)type;
+        if (0 <= type_ && (size_t)type_ < s_Strs.size())
+            return s_Strs[type_];
+        else
+            return "";
+    }
+
+    static constexpr const ModelInfo *FindModelInfo(Type type) {
+        const s16 type_ = (s16)type;
+        if (0 <= type_ && (size_t)type_ < s_ModelInfos.size())
+            return &s_ModelInfos[type_];
+        else
+            return nullptr;
+    }
+}
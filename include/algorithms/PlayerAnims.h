@@ -1155,9 +1155,61 @@ namespace PlayerAnims {
 
     static constexpr const char *FindStr(Type type) {
         const s16 type_ = (s16)type;
-        if (0 <= type_ && type_ < s_Strs.size())
+        if (0 <= type_ && (size_t)type_ < s_Strs.size())
             return s_Strs[type_];
         else
             return "";
     }
+
+    // per animation properties, generated from the names in s_Strs at compile time so checking one is an array load
+    enum Flag : u8 {
+        Flag_None = 0,
+        Flag_NeedBlending = 1 << 0,  // driven by the six move blend weights (Move, Sand and MotorcycleRide animations)
+        Flag_Loop = 1 << 1,          // explicit loop variant of another animation
+        Flag_Capture = 1 << 2,       // played by a capture instead of mario
+    };
+
+    static constexpr bool ContainsStr(std::string_view str, std::string_view subStr) {
+        return str.find(subStr) != std::string_view::npos;
+    }
+
+    static constexpr u8 CalcFlags(size_t index) {
+        std::string_view name = s_Strs[index];
+        u8 flags = Flag_None;
+
+        if (ContainsStr(name, "Move") || ContainsStr(name, "Sand") || ContainsStr(name, "MotorcycleRide"))
+            flags |= Flag_NeedBlending;
+
+        if (name.ends_with("Loop"))
+            flags |= Flag_Loop;
+
+        if (index >= ToValue(Type::BubbleCannonJump))
+            flags |= Flag_Capture;
+
+        return flags;
+    }
+
+    static constexpr std::array<u8, ToValue(Type::End)> s_Flags = [] {
+        std::array<u8, ToValue(Type::End)> flags {};
+        for (size_t i = 0; i < flags.size(); i++) {
+            flags[i] = CalcFlags(i);
+        }
+        return flags;
+    }();
+
+    static constexpr u8 GetFlags(Type type) {
+        const s16 type_ = (s16)type;
+        if (0 <= type_ && (size_t)type_ < s_Flags.size())
+            return s_Flags[type_];
+        else
+            return Flag_None;
+    }
+
+    static constexpr bool IsNeedBlending(Type type) { return GetFlags(type) & Flag_NeedBlending; }
+    static constexpr bool IsLoop(Type type) { return GetFlags(type) & Flag_Loop; }
+    static constexpr bool IsCapture(Type type) { return GetFlags(type) & Flag_Capture; }
+
+    static_assert(IsNeedBlending(Type::Move) && IsNeedBlending(Type::SandWalk) && IsNeedBlending(Type::MotorcycleRideJump));
+    static_assert(!IsNeedBlending(Type::DamageDown) && !IsNeedBlending(Type::Unknown));
+    static_assert(IsLoop(Type::SwoonLoop) && IsCapture(Type::WanwanBig) && !IsCapture(Type::WorldWarpOut));
 }
\ No newline at end of file
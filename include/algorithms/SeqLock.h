@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+#include "basis/seadTypes.h"
+
+// single writer sequence lock. the writer never waits, readers copy the data and retry if a write
+// happened during the copy, so a reader only ever sees a complete sample.
+template <typename T>
+class SeqLock {
+    // sead math types have user defined copy operators, so only check that plain copies are safe
+    static_assert(std::is_standard_layout_v<T> && std::is_trivially_destructible_v<T>, "SeqLock data is copied with memcpy");
+
+public:
+    // only one thread may write. the returned data can be read and modified until endWrite is called
+    T& beginWrite() {
+        mSeq.store(mSeq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        return mData;
+    }
+
+    void endWrite() {
+        mSeq.store(mSeq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // copies the latest sample into out if one was published since lastSeq. gives up after a few attempts
+    // instead of spinning on a busy writer, in which case the caller keeps its previous sample.
+    bool tryRead(T& out, u32& lastSeq) const {
+        for (int i = 0; i < sMaxReadAttempts; i++) {
+            u32 seq = mSeq.load(std::memory_order_acquire);
+
+            if (seq == lastSeq)
+                return false;
+
+            if (seq & 1)
+                continue;  // write in progress
+
+            memcpy((void*)&out, (const void*)&mData, sizeof(T));
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (mSeq.load(std::memory_order_relaxed) == seq) {
+                lastSeq = seq;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+private:
+    static constexpr int sMaxReadAttempts = 4;
+
+    std::atomic<u32> mSeq = 0;
+    T mData = {};
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "basis/seadTypes.h"
+#include "game/GameData/GameDataFile.h"
+
+class Shine;
+
+// open addressing map from a shine unique ID to its HintInfo in the save file and its actor in the current stage, so
+// shine sync doesn't have to scan the hint list or the stage shines for every ID. uses linear probing and entries are
+// never erased, the whole index is cleared when the stage changes. capacity has to be a power of two and at least
+// twice the hint list size.
+template <int Capacity>
+class ShineIndex {
+public:
+    static constexpr int cHintCount = 0x400;  // size of GameDataFile::mShineHintList
+    static constexpr s32 cInvalidUid = -1;
+
+    static_assert((Capacity & (Capacity - 1)) == 0, "ShineIndex capacity must be a power of two");
+    static_assert(Capacity >= cHintCount * 2, "ShineIndex capacity is too small for the hint list");
+
+    ShineIndex() { clear(); }
+
+    void clear() {
+        mHintList = nullptr;
+
+        for (int i = 0; i < Capacity; i++) {
+            mEntries[i].shine = nullptr;
+            mEntries[i].uid = cInvalidUid;
+            mEntries[i].hintIndex = -1;
+        }
+    }
+
+    bool isBuilt() const { return mHintList != nullptr; }
+
+    // adds every shine of the save file, duplicate IDs keep the first hint just like GameDataFile::findShine
+    void build(GameDataFile::HintInfo* hintList) {
+        clear();
+        mHintList = hintList;
+
+        for (s16 i = 0; i < cHintCount; i++) {
+            Entry* entry = findOrAdd(hintList[i].mUniqueID);
+
+            if (entry && entry->hintIndex < 0)
+                entry->hintIndex = i;
+        }
+    }
+
+    void setShine(s32 uid, Shine* shine) {
+        Entry* entry = findOrAdd(uid);
+
+        if (entry)
+            entry->shine = shine;
+    }
+
+    Shine* getShine(s32 uid) const {
+        const Entry* entry = find(uid);
+        return entry ? entry->shine : nullptr;
+    }
+
+    GameDataFile::HintInfo* getHintInfo(s32 uid) const {
+        const Entry* entry = find(uid);
+        return entry && entry->hintIndex >= 0 ? &mHintList[entry->hintIndex] : nullptr;
+    }
+
+private:
+    static constexpr u32 cMask = Capacity - 1;
+
+    struct Entry {
+        Shine* shine;
+        s32 uid;
+        s16 hintIndex;
+    };
+
+    // shine IDs are small sequential numbers, so spread them out before masking
+    static u32 calcIndex(s32 uid) { return ((u32)uid * 0x9E3779B1) >> 16 & cMask; }
+
+    const Entry* find(s32 uid) const {
+        if (uid < 0)
+            return nullptr;
+
+        for (u32 i = calcIndex(uid);; i = (i + 1) & cMask) {
+            const Entry& entry = mEntries[i];
+
+            if (entry.uid == cInvalidUid)
+                return nullptr;
+
+            if (entry.uid == uid)
+                return &entry;
+        }
+    }
+
+    Entry* findOrAdd(s32 uid) {
+        if (uid < 0)
+            return nullptr;
+
+        for (u32 i = calcIndex(uid);; i = (i + 1) & cMask) {
+            Entry& entry = mEntries[i];
+
+            if (entry.uid == uid)
+                return &entry;
+
+            if (entry.uid == cInvalidUid) {
+                entry.uid = uid;
+                return &entry;
+            }
+        }
+    }
+
+    GameDataFile::HintInfo* mHintList = nullptr;
+    Entry mEntries[Capacity];
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstring>
+#include "basis/seadTypes.h"
+#include "nn/account.h"
+
+// open addressing map from a player Uid to its puppet slot. uses linear probing with backward shift deletion, so
+// lookups never have to skip tombstones. capacity has to be a power of two and at least twice the slot count.
+template <int Capacity>
+class UidIndex {
+    static_assert((Capacity & (Capacity - 1)) == 0, "UidIndex capacity must be a power of two");
+
+public:
+    static constexpr s8 cInvalidSlot = -1;
+
+    UidIndex() { clear(); }
+
+    void clear() {
+        for (int i = 0; i < Capacity; i++) {
+            mEntries[i].slot = cInvalidSlot;
+        }
+    }
+
+    s8 find(const nn::account::Uid& id) const {
+        for (u32 i = calcIndex(id);; i = (i + 1) & cMask) {
+            const Entry& entry = mEntries[i];
+
+            if (entry.slot == cInvalidSlot)
+                return cInvalidSlot;
+
+            if (entry.id == id)
+                return entry.slot;
+        }
+    }
+
+    // adds or replaces the slot for id
+    void insert(const nn::account::Uid& id, s8 slot) {
+        for (u32 i = calcIndex(id);; i = (i + 1) & cMask) {
+            Entry& entry = mEntries[i];
+
+            if (entry.slot == cInvalidSlot || entry.id == id) {
+                entry.id = id;
+                entry.slot = slot;
+                return;
+            }
+        }
+    }
+
+    void erase(const nn::account::Uid& id) {
+        u32 hole = calcIndex(id);
+
+        while (true) {
+            if (mEntries[hole].slot == cInvalidSlot)
+                return;
+
+            if (mEntries[hole].id == id)
+                break;
+
+            hole = (hole + 1) & cMask;
+        }
+
+        // move following entries of the probe chain back into the hole so they stay reachable
+        for (u32 i = (hole + 1) & cMask; mEntries[i].slot != cInvalidSlot; i = (i + 1) & cMask) {
+            u32 home = calcIndex(mEntries[i].id);
+
+            if (((i - home) & cMask) >= ((i - hole) & cMask)) {
+                mEntries[hole] = mEntries[i];
+                hole = i;
+            }
+        }
+
+        mEntries[hole].slot = cInvalidSlot;
+    }
+
+private:
+    static constexpr u32 cMask = Capacity - 1;
+
+    struct Entry {
+        nn::account::Uid id;
+        s8 slot;
+    };
+
+    // uids are random enough that folding the two halves is a good hash
+    static u32 calcIndex(const nn::account::Uid& id) {
+        u64 parts[2];
+        memcpy(parts, id.data, sizeof(parts));
+        u64 hash = parts[0] ^ parts[1];
+        return (u32)(hash ^ (hash >> 29) ^ (hash >> 47)) & cMask;
+    }
+
+    Entry mEntries[Capacity];
+};
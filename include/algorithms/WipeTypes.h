@@ -73,7 +73,7 @@ namespace WipeTypes {
 
     static constexpr const char *FindStr(Type type) {
         const s16 type_ = (s16)type;
-        if (0 <= type_ && type_ < s_Strs.size())
+        if (0 <= type_ && (size_t)type_ < s_Strs.size())
             return s_Strs[type_];
         else
             return "";
@@ -7,9 +7,11 @@
 #include <set>
 #include <stdint.h>
 #include <stdio.h>
-// these ifdefs are really dumb but it makes clangd happy so /shrug
-#ifndef ANALYZER
-#include <ranges>
+#include <string.h>
+#include <type_traits>
+
+#ifdef __ARM_FEATURE_CRC32
+#include <arm_acle.h>
 #endif
 
 // Credits to Shadow for making a majority of this code for me!
@@ -72,51 +74,214 @@ namespace crc32 {
         0x2d02ef8dL
     };
 
+    // s_SliceTables[n][b] is the crc of byte b followed by n zero bytes, lets the fallback do 8 bytes per step
+    static constexpr auto s_SliceTables = [] {
+        std::array<std::array<uint32_t, 256>, 8> tables {};
+
+        for (int b = 0; b < 256; b++) {
+            tables[0][b] = s_Table[b];
+        }
+
+        for (int n = 1; n < 8; n++) {
+            for (int b = 0; b < 256; b++) {
+                uint32_t prev = tables[n - 1][b];
+                tables[n][b] = (prev >> 8) ^ s_Table[prev & 0xff];
+            }
+        }
+
+        return tables;
+    }();
+
+    constexpr uint32_t UpdateByte(uint32_t crc, char c) {
+        return (crc >> 8) ^ s_Table[(crc ^ c) & 0xff];
+    }
+
+    // same result as the byte table, but uses the crc32 instructions on the switch and slice by 8 elsewhere
+    inline uint32_t UpdateRuntime(uint32_t crc, const char* data, size_t size) {
+        for (; size >= 8; data += 8, size -= 8) {
+            uint64_t word;
+            memcpy(&word, data, sizeof(word));
+
+#ifdef __ARM_FEATURE_CRC32
+            crc = __crc32d(crc, word);
+#else
+            word ^= crc;
+            crc = s_SliceTables[7][word & 0xff] ^ s_SliceTables[6][(word >> 8) & 0xff] ^
+                  s_SliceTables[5][(word >> 16) & 0xff] ^ s_SliceTables[4][(word >> 24) & 0xff] ^
+                  s_SliceTables[3][(word >> 32) & 0xff] ^ s_SliceTables[2][(word >> 40) & 0xff] ^
+                  s_SliceTables[1][(word >> 48) & 0xff] ^ s_SliceTables[0][word >> 56];
+#endif
+        }
+
+        for (; size > 0; data++, size--) {
+#ifdef __ARM_FEATURE_CRC32
+            crc = __crc32b(crc, *data);
+#else
+            crc = UpdateByte(crc, *data);
+#endif
+        }
+
+        return crc;
+    }
+
     constexpr uint32_t HashStr(std::string_view const& str)
     {
         uint32_t crc = 0xffffffff;
+
+        if (!std::is_constant_evaluated())
+            return UpdateRuntime(crc, str.data(), str.size()) ^ 0xffffffff;
+
         for (auto c : str)
-            crc = (crc >> 8) ^ s_Table[(crc ^ c) & 0xff];
+            crc = UpdateByte(crc, c);
         return crc ^ 0xffffffff;
     }
 
+    static_assert(HashStr("123456789") == 0xCBF43926, "crc32 check value");
+
+    // deliberately not constexpr, calling it while building a HashArray turns a crc32 collision between two different
+    // strings into a compile error instead of one of them silently never being found
+    void HashArrayCollision(const char* first, const char* second);
+
+    // scrambles a crc with a seed, used to pick buckets and slots in HashArray
+    constexpr uint32_t MixHash(uint32_t hash, uint32_t seed) {
+        hash ^= seed * 0x9e3779b9;
+        hash ^= hash >> 16;
+        hash *= 0x85ebca6b;
+        hash ^= hash >> 13;
+        hash *= 0xc2b2ae35;
+        hash ^= hash >> 16;
+        return hash;
+    }
+
+    // minimal perfect hash from a string to its index in the array it was built from, generated at compile time using
+    // hash and displace. the crc picks a bucket, each bucket stores the seed that sends all of its strings to free
+    // slots (or the slot itself for buckets with a single string), so a lookup is one probe and one string compare.
     template<size_t Length>
     struct HashArray  {
-        using HashType = std::uint32_t;
-        using PairType = std::pair<HashType, int>;
-        using HashArrayType = std::array<PairType, Length>;
-        
-        HashArrayType m_Hashes;
-
-        constexpr HashArray(std::array<const char*, Length> const& strings) : m_Hashes() {
-            /* Hash and store all provided strings. */
-            for(size_t i = 0; i < strings.size(); i++) {
-                m_Hashes[i] = { crc32::HashStr(strings[i]), i };
+        static constexpr size_t BucketCount = Length / 2 > 0 ? Length / 2 : 1;
+
+        std::array<const char*, Length> m_Strings;
+        std::array<std::int32_t, BucketCount> m_Displacements;  // >= 0 is a seed, < 0 is -(slot + 1)
+        std::array<std::int16_t, Length> m_Slots;               // index into m_Strings, -1 for unused
+
+        constexpr HashArray(std::array<const char*, Length> const& strings) : m_Strings(strings), m_Displacements(), m_Slots() {
+            static_assert(Length < 0x8000, "HashArray slots are stored as s16");
+
+            std::array<uint32_t, Length> hashes {};
+            std::array<uint32_t, Length> buckets {};
+            std::array<std::int16_t, Length> order {};
+
+            for (size_t i = 0; i < Length; i++) {
+                hashes[i] = crc32::HashStr(strings[i]);
+                buckets[i] = MixHash(hashes[i], 0) % BucketCount;
+                order[i] = i;
+                m_Slots[i] = -1;
             }
 
-            /* Sort by hashes. */
-            std::sort(m_Hashes.begin(), m_Hashes.end(), [](auto &left, auto &right) {
-                return left.first < right.first;
+            // group the strings by bucket, equal hashes end up next to each other with the lowest index first
+            std::sort(order.begin(), order.end(), [&](std::int16_t a, std::int16_t b) {
+                if (buckets[a] != buckets[b])
+                    return buckets[a] < buckets[b];
+                if (hashes[a] != hashes[b])
+                    return hashes[a] < hashes[b];
+                return a < b;
             });
+
+            /* Drop duplicate strings (the first index is kept), different strings with the same crc can't be told apart. */
+            std::array<std::int16_t, Length> members {};
+            std::array<size_t, BucketCount + 1> bucketStarts {};
+            size_t memberCount = 0;
+
+            for (size_t i = 0; i < Length; i++) {
+                std::int16_t index = order[i];
+
+                if (i > 0 && hashes[order[i - 1]] == hashes[index]) {
+                    if (std::string_view(strings[order[i - 1]]) != std::string_view(strings[index]))
+                        HashArrayCollision(strings[order[i - 1]], strings[index]);
+                    continue;
+                }
+
+                members[memberCount++] = index;
+                bucketStarts[buckets[index] + 1] = memberCount;
+            }
+
+            for (size_t bucket = 1; bucket <= BucketCount; bucket++) {
+                bucketStarts[bucket] = std::max(bucketStarts[bucket], bucketStarts[bucket - 1]);
+            }
+
+            // place the biggest buckets first while most slots are still free
+            std::array<std::int16_t, BucketCount> bucketOrder {};
+            for (size_t bucket = 0; bucket < BucketCount; bucket++) {
+                bucketOrder[bucket] = bucket;
+            }
+
+            std::sort(bucketOrder.begin(), bucketOrder.end(), [&](std::int16_t a, std::int16_t b) {
+                size_t sizeA = bucketStarts[a + 1] - bucketStarts[a];
+                size_t sizeB = bucketStarts[b + 1] - bucketStarts[b];
+                return sizeA != sizeB ? sizeA > sizeB : a < b;
+            });
+
+            size_t freeSlot = 0;
+
+            for (std::int16_t bucket : bucketOrder) {
+                size_t first = bucketStarts[bucket];
+                size_t size = bucketStarts[bucket + 1] - first;
+
+                if (size == 0)
+                    break;
+
+                /* Single string buckets go straight into the remaining slots. */
+                if (size == 1) {
+                    while (m_Slots[freeSlot] != -1) {
+                        freeSlot++;
+                    }
+
+                    m_Slots[freeSlot] = members[first];
+                    m_Displacements[bucket] = -(std::int32_t)(freeSlot + 1);
+                    continue;
+                }
+
+                for (uint32_t seed = 1;; seed++) {
+                    std::array<uint32_t, Length> placed {};
+                    size_t placedCount = 0;
+
+                    for (; placedCount < size; placedCount++) {
+                        uint32_t slot = MixHash(hashes[members[first + placedCount]], seed) % Length;
+                        bool isFree = m_Slots[slot] == -1;
+
+                        for (size_t p = 0; p < placedCount && isFree; p++) {
+                            isFree = placed[p] != slot;
+                        }
+
+                        if (!isFree)
+                            break;
+
+                        placed[placedCount] = slot;
+                    }
+
+                    if (placedCount != size)
+                        continue;
+
+                    for (size_t p = 0; p < size; p++) {
+                        m_Slots[placed[p]] = members[first + p];
+                    }
+
+                    m_Displacements[bucket] = seed;
+                    break;
+                }
+            }
         }
 
         constexpr std::int64_t FindIndex(std::string_view const& str) const {
             auto hash = crc32::HashStr(str);
-            auto begin = m_Hashes.cbegin();
-            auto end = m_Hashes.cend();
-
-#ifndef ANALYZER
-            /* Binary search for string.  */
-            auto pair = std::ranges::lower_bound(begin, end, hash, {}, &PairType::first);
+            std::int32_t displacement = m_Displacements[MixHash(hash, 0) % BucketCount];
+            std::int32_t slot = displacement < 0 ? -displacement - 1 : MixHash(hash, displacement) % Length;
+            std::int16_t index = m_Slots[slot];
 
-            if (pair == end || pair->first != hash)
+            if (index < 0 || std::string_view(m_Strings[index]) != str)
                 return -1;
-            else
-                return pair->second;
-#else
-            return -1;
-#endif
-            
+
+            return index;
         }
     };
 }
\ No newline at end of file
@@ -18,6 +18,7 @@
 #include "logger.hpp"
 #include "server/gamemode/GameModeConfigMenu.hpp"
 #include "server/gamemode/GameModeConfigMenuFactory.hpp"
+#include "server/ThreadConfig.hpp"
 
 class FooterParts;
 
@@ -30,7 +31,8 @@ class StageSceneStateServerConfig : public al::HostStateBase<al::Scene>, public
             GAMEMODECONFIG,
             GAMEMODESWITCH,
             SETIP,
-            SETPORT
+            SETPORT,
+            THREADCONFIG
         };
 
         virtual al::MessageSystem* getMessageSystem(void) const override;
@@ -43,6 +45,7 @@ class StageSceneStateServerConfig : public al::HostStateBase<al::Scene>, public
         void exeOpenKeyboardPort();
         void exeGamemodeConfig();
         void exeGamemodeSelect();
+        void exeThreadConfig();
         void exeSaveData();
 
         void endSubMenu();
@@ -51,6 +54,8 @@ class StageSceneStateServerConfig : public al::HostStateBase<al::Scene>, public
         
         inline void subMenuStart();
         inline void subMenuUpdate();
+
+        void updateThreadConfigStrings();
         
         al::MessageSystem* mMsgSystem = nullptr;
         FooterParts* mFooterParts = nullptr;
@@ -66,6 +71,11 @@ class StageSceneStateServerConfig : public al::HostStateBase<al::Scene>, public
         // Sub-Page of Mode config, used to select a gamemode for the client to use
         SimpleLayoutMenu* mModeSelect = nullptr;
         CommonVerticalList* mModeSelectList = nullptr;
+        // Sub-Page for network thread priority/core config, two entries per thread followed by the cpu time measurement toggle
+        static constexpr int cThreadConfigItemCount = (int)NetThread::End * 2 + 1;
+        SimpleLayoutMenu* mThreadConfig = nullptr;
+        CommonVerticalList* mThreadConfigList = nullptr;
+        sead::SafeArray<sead::WFixedSafeString<0x200>, cThreadConfigItemCount>* mThreadConfigOptions = nullptr;
 
         // Sub-Pages for Mode configuration, has buttons for selecting current gamemode and configuring currently selected mode (if no mode is chosen, button will not do anything)
         struct GameModeEntry {
@@ -85,5 +95,6 @@ namespace {
     NERVE_HEADER(StageSceneStateServerConfig, OpenKeyboardPort)
     NERVE_HEADER(StageSceneStateServerConfig, GamemodeConfig)
     NERVE_HEADER(StageSceneStateServerConfig, GamemodeSelect)
+    NERVE_HEADER(StageSceneStateServerConfig, ThreadConfig)
     NERVE_HEADER(StageSceneStateServerConfig, SaveData)
 }
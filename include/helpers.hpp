@@ -11,6 +11,7 @@
 
 #include "logger.hpp"
 #include "puppets/PuppetInfo.h"
+#include "algorithms/CostumeTypes.h"
 
 #include "game/GameData/GameDataFunction.h"
 
@@ -39,50 +40,6 @@ const char* tryConvertName(const char* className);
 void killMainPlayer(al::LiveActor* actor);
 void killMainPlayer(PlayerActorHakoniwa* mainPlayer);
 
-__attribute__((used)) static const char* costumeNames[] = {
-    "Mario",
-    "Mario64",
-    "Mario64Metal",
-    "MarioAloha",
-    "MarioArmor",
-    "MarioBone",
-    "MarioClown",
-    "MarioColorClassic",
-    "MarioColorGold",
-    "MarioColorLuigi",
-    "MarioColorWaluigi",
-    "MarioColorWario",
-    "MarioCook",
-    "MarioDiddyKong",
-    "MarioDoctor",
-    "MarioExplorer",
-    "MarioFootball",
-    "MarioGolf",
-    "MarioGunman",
-    "MarioHakama",
-    "MarioHappi",
-    "MarioKing",
-    "MarioKoopa",
-    "MarioMaker",
-    "MarioMechanic",
-    "MarioNew3DS",
-    "MarioPainter",
-    "MarioPeach",
-    "MarioPilot",
-    "MarioPirate",
-    "MarioPoncho",
-    "MarioPrimitiveMan",
-    "MarioSailor",
-    "MarioScientist",
-    "MarioShopman",
-    "MarioSnowSuit",
-    "MarioSpaceSuit",
-    "MarioSuit",
-    "MarioSwimwear",
-    "MarioTailCoat",
-    "MarioTuxedo",
-    "MarioUnderwear"
-};
 // full costume list from 1.3
 // attribute otherwise the build log is spammed with unused warnings
 // __attribute__((used)) static const char* costumeNames[] = {
@@ -20,6 +20,7 @@ public:
     void setText(char const*);
 
     bool isNearPlayerActor(float) const;
+    bool isTrackedByQuery() const;
     bool isVisible() const;
 
     const char *getCurrentState();
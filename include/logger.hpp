@@ -1,20 +1,163 @@
 #pragma once
 
+#include <type_traits>
 #include "SocketBase.hpp"
+#include "algorithms/crc32.h"
 #include "types.h"
 
+enum class LogLevel : u8 {
+    Trace,  // per packet/per frame spam
+    Debug,
+    Info,
+    Warn,
+    Error,
+    End
+};
+
+enum class LogCategory : u8 {
+    General,
+    Net,
+    Puppet,
+    GameMode,
+    Boot,
+    Menu,
+    End
+};
+
+// log calls below LOG_COMPILED_LEVEL or outside of LOG_COMPILED_CATEGORIES (bitmask of LogCategory) are removed at compile
+// time, strings included. both can be overridden from the Makefile with LOGFLAGS.
+#ifndef LOG_COMPILED_LEVEL
+#if DEBUGLOG
+#define LOG_COMPILED_LEVEL 0  // Trace
+#else
+#define LOG_COMPILED_LEVEL 3  // Warn
+#endif
+#endif
+
+#ifndef LOG_COMPILED_CATEGORIES
+#define LOG_COMPILED_CATEGORIES 0xFFFFFFFF
+#endif
+
+// when set, LOG_* calls send the crc32 of their format string and the raw arguments instead of formatted text. the
+// format strings are left out of the binary, scripts/genLogTable.py collects them for scripts/tcpServer.py to decode.
+#ifndef LOG_BINARY
+#define LOG_BINARY 0
+#endif
+
+// SD card output for when no log server is connected. defaults to on only in DEBUGLOG builds, release builds create
+// no logger and no flush thread at all unless it's enabled with LOGFLAGS=-DLOG_SD_CARD=1
+#ifndef LOG_SD_CARD
+#if DEBUGLOG
+#define LOG_SD_CARD 1
+#else
+#define LOG_SD_CARD 0
+#endif
+#endif
+
+// binary log streams start with this magic and the u64 system tick frequency, followed by records
+static constexpr char cLogBinaryMagic[8] = {'S', 'M', 'O', 'L', 'O', 'G', 'B', '1'};
+
+enum class LogRecordType : u8 {
+    Format,  // fmtHash + LogArgType tagged arguments
+    Text,    // preformatted text, e.g. from sead::system::print
+    Name     // new logger name, prefixed to every following line
+};
+
+enum class LogArgType : u8 {
+    Int32,
+    Int64,
+    Double,
+    String,  // u16 length followed by the characters
+    Pointer
+};
+
+struct PACKED LogRecordHeader {
+    u16 size;  // bytes following the header
+    LogRecordType type;
+    u8 levelCategory;  // level in the upper 4 bits, category in the lower 4
+    u32 fmtHash;
+    u64 tick;
+};
+
+// serializes printf arguments for a Format record, anything past cMaxSize is dropped
+class LogArgWriter {
+public:
+    static constexpr u32 cMaxSize = 0x180;
+
+    template <typename T>
+    void write(T value) {
+        if constexpr (std::is_same_v<std::decay_t<T>, char*> || std::is_same_v<std::decay_t<T>, const char*>) {
+            if (!writeTag(LogArgType::String, sizeof(u16)))
+                return;
+            u16 len = value ? strnlen(value, cMaxSize - mSize - sizeof(u16)) : 0;
+            writeRaw(&len, sizeof(len));
+            writeRaw(value, len);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            double val = value;
+            if (writeTag(LogArgType::Double, sizeof(val)))
+                writeRaw(&val, sizeof(val));
+        } else if constexpr (std::is_pointer_v<T>) {
+            u64 val = (u64)value;
+            if (writeTag(LogArgType::Pointer, sizeof(val)))
+                writeRaw(&val, sizeof(val));
+        } else if constexpr (sizeof(T) <= sizeof(s32)) {
+            s32 val = (s32)value;
+            if (writeTag(LogArgType::Int32, sizeof(val)))
+                writeRaw(&val, sizeof(val));
+        } else {
+            s64 val = (s64)value;
+            if (writeTag(LogArgType::Int64, sizeof(val)))
+                writeRaw(&val, sizeof(val));
+        }
+    }
+
+    const u8* getData() const { return mData; }
+    u32 getSize() const { return mSize; }
+
+private:
+    bool writeTag(LogArgType type, u32 valueSize) {
+        if (mSize + 1 + valueSize > cMaxSize)
+            return false;
+        mData[mSize++] = (u8)type;
+        return true;
+    }
+
+    void writeRaw(const void* src, u32 size) {
+        memcpy(mData + mSize, src, size);
+        mSize += size;
+    }
+
+    u8 mData[cMaxSize];
+    u32 mSize = 0;
+};
+
 class Logger : public SocketBase {
     public:
         Logger(const char* ip, u16 port, const char* name) : SocketBase(name) {
+            #if DEBUGLOG
             this->init(ip, port);
+            #else
+            (void)ip;
+            (void)port;
+            #endif
+            // without a log server the flush thread writes to the SD card instead, if LOG_SD_CARD is set
+            this->startFlushThread();
         };
         nn::Result init(const char* ip, u16 port) override;
         
         static void createInstance();
-        static void setLogName(const char *name) { if(sInstance) sInstance->setName(name); }
+        static void setLogName(const char *name);
         static void log(const char* fmt, ...);
         static void line(const char* fmt, ...);
-        static void log(const char* fmt, va_list args);
+        // for printf style hooks like sead::system::print, filtered with isEnabled before anything is formatted
+        static void log(LogLevel level, LogCategory category, const char* fmt, va_list args);
+
+        template <typename... Args>
+        static void logBinary(LogLevel level, LogCategory category, u32 fmtHash, Args... args) {
+            LogArgWriter writer;
+            (writer.write(args), ...);
+            pushFormat(level, category, fmtHash, writer);
+        }
 
         static void enableName() { if(sInstance) sInstance->isDisableName = false; }
         static void disableName() { if(sInstance) sInstance->isDisableName = true; }
@@ -22,7 +165,72 @@ class Logger : public SocketBase {
         int read(char *out);
         bool pingSocket();
 
+        // messages dropped because the log ring was full
+        static u32 getDropCount();
+
+        // writes the buffered SD card log on the next flush, called on scene transitions
+        static void requestFileFlush();
+        static const char* getOutputName();
+
+        static constexpr bool isCompiled(LogLevel level, LogCategory category) {
+            return (int)level >= LOG_COMPILED_LEVEL && (LOG_COMPILED_CATEGORIES & (1u << (int)category));
+        }
+
+        // runtime filter, checked before any of the log arguments are evaluated
+        static bool isEnabled(LogLevel level, LogCategory category) {
+            return sInstance && level >= sMinLevel && (sCategoryMask & (1u << (int)category));
+        }
+
+        static LogLevel getMinLevel() { return sMinLevel; }
+        static void setMinLevel(LogLevel level) { sMinLevel = level; }
+        static void cycleMinLevel();
+        static u32 getCategoryMask() { return sCategoryMask; }
+        static void setCategoryMask(u32 mask) { sCategoryMask = mask; }
+        static void setCategoryEnabled(LogCategory category, bool isEnable);
+
+        static const char* getLevelName(LogLevel level);
+        static const char* getCategoryName(LogCategory category);
+
     private:
+        static void push(const char* str, int len);
+        static void pushText(LogLevel level, LogCategory category, const char* str, int len);
+        static void pushFormat(LogLevel level, LogCategory category, u32 fmtHash, const LogArgWriter& args);
+        static void pushName(const char* name);
+        static void flushThreadFunc(void* arg);
+
+        void startFlushThread();
+        void flush();
+        void writeOutput(const char* data, u32 len);
+        u32 makeHandshake(char* out);
+
+        bool openLogFile();
+        void writeLogFile(const char* data, u32 len);
+        void flushLogFile();
+
         static Logger* sInstance;
+        static LogLevel sMinLevel;
+        static u32 sCategoryMask;
         bool isDisableName;
-};
\ No newline at end of file
+};
+
+#if LOG_BINARY
+#define LOG_EMIT(level, category, fmt, ...)                                                     \
+    Logger::logBinary(LogLevel::level, LogCategory::category,                                   \
+                      std::integral_constant<u32, crc32::HashStr(fmt)>::value __VA_OPT__(, ) __VA_ARGS__)
+#else
+#define LOG_EMIT(level, category, fmt, ...) Logger::log(fmt __VA_OPT__(, ) __VA_ARGS__)
+#endif
+
+#define LOG_AT(level, category, fmt, ...)                                                       \
+    do {                                                                                        \
+        if constexpr (Logger::isCompiled(LogLevel::level, LogCategory::category)) {            \
+            if (Logger::isEnabled(LogLevel::level, LogCategory::category))                      \
+                LOG_EMIT(level, category, fmt __VA_OPT__(, ) __VA_ARGS__);                      \
+        }                                                                                       \
+    } while (0)
+
+#define LOG_TRACE(category, ...) LOG_AT(Trace, category, __VA_ARGS__)
+#define LOG_DEBUG(category, ...) LOG_AT(Debug, category, __VA_ARGS__)
+#define LOG_INFO(category, ...) LOG_AT(Info, category, __VA_ARGS__)
+#define LOG_WARN(category, ...) LOG_AT(Warn, category, __VA_ARGS__)
+#define LOG_ERROR(category, ...) LOG_AT(Error, category, __VA_ARGS__)
\ No newline at end of file
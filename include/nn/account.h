@@ -38,18 +38,18 @@ namespace nn
             }
 
             inline void print() const {
-                Logger::log("Player ID: 0x");
+                LOG_DEBUG(General, "Player ID: 0x");
                 Logger::disableName();
-                for (size_t i = 0; i < 0x10; i++) { Logger::log("%02X", data[i]); }
-                Logger::log("\n");
+                for (size_t i = 0; i < 0x10; i++) { LOG_DEBUG(General, "%02X", data[i]); }
+                LOG_DEBUG(General, "\n");
                 Logger::enableName();
             }
 
             inline void print(const char *prefix) const {
-                Logger::log("%s: 0x", prefix);
+                LOG_DEBUG(General, "%s: 0x", prefix);
                 Logger::disableName();
-                for (size_t i = 0; i < 0x10; i++) { Logger::log("%02X", data[i]); }
-                Logger::log("\n");
+                for (size_t i = 0; i < 0x10; i++) { LOG_DEBUG(General, "%02X", data[i]); }
+                LOG_DEBUG(General, "\n");
                 Logger::enableName();
             }
 
@@ -28,7 +28,8 @@ enum OpenMode
 {
     OpenMode_Read       = 1 << 0,
     OpenMode_Write      = 1 << 1,
-    OpenMode_ReadWrite  = OpenMode_Read | OpenMode_Write
+    OpenMode_ReadWrite  = OpenMode_Read | OpenMode_Write,
+    OpenMode_Append     = 1 << 2
 };
 
 enum DirectoryMode
@@ -176,6 +176,7 @@ void ResumeThread(nn::os::ThreadType*);
 void SleepThread(nn::TimeSpan);
 void WaitThread(nn::os::ThreadType*);
 void SetThreadCoreMask(nn::os::ThreadType*, int, u64 mask);
+void GetThreadCoreMask(int* outIdealCore, u64* outMask, nn::os::ThreadType const*);
 
 // EVENTS
 void InitializeEvent(EventType*, bool initiallySignaled, bool autoclear);
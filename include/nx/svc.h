@@ -16,5 +16,16 @@ extern "C" {
  */
 Result svcOutputDebugString(const char *str, u64 size);
 
+/**
+ * @brief Retrieves information about the system, or a certain kernel object.
+ * @param[out] out Variable to which store the information.
+ * @param[in] id0 First ID of the property to retrieve.
+ * @param[in] handle Handle of the object to retrieve information from, or 0 to retrieve information about the system.
+ * @param[in] id1 Second ID of the property to retrieve.
+ * @return Result code.
+ * @note Syscall number 0x29.
+ */
+Result svcGetInfo(u64 *out, u32 id0, u32 handle, u64 id1);
+
 
 }
\ No newline at end of file
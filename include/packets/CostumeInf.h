@@ -1,15 +1,30 @@
 #pragma once
 
 #include "Packet.h"
+#include "algorithms/CostumeTypes.h"
+
+#include <cstddef>
 
 struct PACKED CostumeInf : Packet {
-    CostumeInf() : Packet() {this->mType = PacketType::COSTUMEINF;  mPacketSize = sizeof(CostumeInf) - sizeof(Packet);};
+    CostumeInf() : Packet() {this->mType = PacketType::COSTUMEINF; mPacketSize = offsetof(CostumeInf, bodyModel) - sizeof(Packet);};
     CostumeInf(const char* body, const char* cap) : Packet() {
         this->mType = PacketType::COSTUMEINF;
-        mPacketSize = sizeof(CostumeInf) - sizeof(Packet);
-        strcpy(bodyModel, body);
-        strcpy(capModel, cap);
+        bodyType = CostumeTypes::FindType(body);
+        capType = CostumeTypes::FindType(cap);
+        // custom costumes aren't in the costume table, so send their names as well
+        if (bodyType == CostumeTypes::Type::Unknown || capType == CostumeTypes::Type::Unknown) {
+            strncpy(bodyModel, body, COSTUMEBUFSIZE - 1);
+            strncpy(capModel, cap, COSTUMEBUFSIZE - 1);
+            mPacketSize = sizeof(CostumeInf) - sizeof(Packet);
+        } else {
+            mPacketSize = offsetof(CostumeInf, bodyModel) - sizeof(Packet);
+        }
     }
+    CostumeTypes::Type bodyType = CostumeTypes::Type::Unknown;
+    CostumeTypes::Type capType = CostumeTypes::Type::Unknown;
+    // only present if the packet size includes them, check with hasModelNames before reading
     char bodyModel[COSTUMEBUFSIZE] = {};
     char capModel[COSTUMEBUFSIZE] = {};
-};
\ No newline at end of file
+
+    bool hasModelNames() const { return mPacketSize >= (short)(sizeof(CostumeInf) - sizeof(Packet)); }
+};
@@ -1,11 +1,12 @@
 #pragma once
 
 #include "Packet.h"
+#include "algorithms/CapAnims.h"
 
 struct PACKED HackCapInf : Packet {
     HackCapInf() : Packet() {this->mType = PacketType::HACKCAPINF; mPacketSize = sizeof(HackCapInf) - sizeof(Packet);};
     sead::Vector3f capPos;
     sead::Quatf capQuat;
     bool1 isCapVisible = false;
-    char capAnim[PACKBUFSIZE] = {};
+    CapAnims::Type capAnim = CapAnims::Type::Unknown;
 };
\ No newline at end of file
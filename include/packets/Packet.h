@@ -11,6 +11,7 @@
 #define COSTUMEBUFSIZE   0x20
 
 #define MAXPACKSIZE      0x100
+#define MAXSHINESYNCSIZE 0x240 // ShineSync is the only packet allowed past MAXPACKSIZE
 
 enum PacketType : short {
     UNKNOWN,
@@ -28,6 +29,7 @@ enum PacketType : short {
     CMD,
     UDPINIT,
     HOLEPUNCH,
+    SHINESYNC,
     End // end of enum for bounds checking
 };
 
@@ -48,6 +50,7 @@ USED static const char *packetNames[] = {
     "Server Command",
     "Udp Initialization",
     "Hole punch",
+    "Moon Sync",
 };
 
 enum SenderType {
@@ -89,3 +92,4 @@ struct PACKED Packet {
 #include "packets/InitPacket.h"
 #include "packets/UdpPacket.h"
 #include "packets/HolePunchPacket.h"
+#include "packets/ShineSync.h"
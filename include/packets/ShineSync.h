@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Packet.h"
+
+// every shine collected on the server in one packet, sent instead of a ShineCollect per shine when a client joins or
+// reconnects. the collected set is a bitmap (bit n of byte b is shine ID b * 8 + n) compressed into runs, each run
+// starts with a control byte:
+//   0b00nnnnnn  n + 1 literal bitmap bytes follow
+//   0b10nnnnnn  n + 1 bitmap bytes of 0x00
+//   0b11nnnnnn  n + 1 bitmap bytes of 0xFF
+struct PACKED ShineSync : Packet {
+    ShineSync() : Packet() {this->mType = PacketType::SHINESYNC; mPacketSize = sizeof(ShineSync) - sizeof(Packet);};
+    u16 bitmapSize = 0; // decoded size in bytes
+    u8 runs[MAXSHINESYNCSIZE - sizeof(Packet) - sizeof(u16)] = {};
+
+    static constexpr u8 cRunLiteral = 0x00;
+    static constexpr u8 cRunZero = 0x80;
+    static constexpr u8 cRunOne = 0xC0;
+    static constexpr u8 cRunTypeMask = 0xC0;
+    static constexpr u8 cRunLengthMask = 0x3F;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "types.h"
+
+class PuppetHackActor;
+struct PuppetInfo;
+
+// capture actors shared by every puppet. each capture type in the stage gets a few PuppetHackActors, which are leased
+// to a puppet while it's in that capture, instead of every puppet owning one of each type.
+class CaptureActorPool {
+public:
+    static constexpr int cMaxActors = 160;
+    // how many puppets can be in the same capture at once, puppets past this are shown as mario
+    static constexpr int cMaxActorsPerType = 4;
+
+    // called at stage init, the previous stage's actors were freed along with its heap
+    static void reset();
+
+    // actors to create for each capture type when puppetCount puppets can capture
+    static int calcTypeSize(int puppetCount) { return puppetCount < cMaxActorsPerType ? puppetCount : cMaxActorsPerType; }
+
+    static int getTypeCount(const char* hackName);
+    static bool addActor(PuppetHackActor* actor, const char* hackName);
+
+    // returns a free actor for the capture type and points it at info, or null if there are none left
+    static PuppetHackActor* lease(const char* hackName, PuppetInfo* info);
+    static void release(PuppetHackActor* actor);
+
+    static int getActorCount() { return sCount; }
+    static int getLeasedCount();
+
+private:
+    struct Entry {
+        PuppetHackActor* actor;
+        bool isLeased;
+        char hackName[0x20];
+    };
+
+    static Entry sEntries[cMaxActors];
+    static int sCount;
+};
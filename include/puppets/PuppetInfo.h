@@ -1,7 +1,11 @@
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 #include "algorithms/PlayerAnims.h"
+#include "algorithms/CapAnims.h"
+#include "algorithms/CostumeTypes.h"
+#include "algorithms/SeqLock.h"
 #include "packets/Packet.h"
 
 #include "al/LiveActor/LiveActor.h"
@@ -11,47 +15,93 @@
 #include "sead/math/seadVector.h"
 #include "sead/math/seadQuat.h"
 
-struct PuppetInfo {
-    // General Puppet Info
-    char puppetName[0x10] = {}; // max user account name size is 10 chars, so this could go down to 0xB
-    bool isConnected = false;
-    nn::account::Uid playerID;
+// state received by the network thread, published as one sample so the game thread never sees a half written
+// position, rotation, stage name or model name
+struct PuppetSample {
     // Puppet Translation Info
     sead::Vector3f playerPos = sead::Vector3f(0.f,0.f,0.f);
     sead::Quatf playerRot = sead::Quatf(0.f,0.f,0.f,0.f);
     // Puppet Stage Info
     u8 scenarioNo = -1;
     char stageName[0x40] = {};
-    bool isInSameStage = false;
+    // Puppet Model Info
+    PlayerAnims::Type curAnim = PlayerAnims::Type::Unknown;
+    PlayerAnims::Type curSubAnim = PlayerAnims::Type::Unknown;
+    float blendWeights[6] = {};
+    bool is2D = false;
+    // Puppet Hack Cap Info
+    sead::Vector3f capPos = sead::Vector3f(0.f,0.f,0.f);
+    sead::Quatf capRot = sead::Quatf(0.f,0.f,0.f,0.f);
+    CapAnims::Type capAnim = CapAnims::Type::Unknown;
+    bool isCapThrow = false;
+    // Puppet Capture Info
+    bool isCaptured = false;
+    char curHack[0x40] = {};
     // Puppet Costume Info
+    CostumeTypes::Type costumeBodyType = CostumeTypes::Type::Unknown;
+    CostumeTypes::Type costumeHeadType = CostumeTypes::Type::Unknown;
     char costumeBody[0x20] = {};
     char costumeHead[0x20] = {};
-    // Puppet Capture Info
-    char curHack[0x40] = {};
+};
+
+// fields are grouped by how often they're read. the first cache line holds everything the per-frame loops over all
+// puppets check (game modes, name tags, PuppetHolder), the second what PuppetActor::control reads for visible
+// puppets, and the rest is only touched on packets or by the debug menu. Client allocates all infos as one
+// contiguous, cache line aligned block.
+struct PuppetInfo {
+    // --- Hot: per-frame puppet loops ---
+    bool isConnected = false;
+    bool isInSameStage = false;
+    bool is2D = false;
     bool isCaptured = false;
-    bool isStartCapture = false;
+    // Hide and Seek Gamemode Info
+    bool isIt = false;
+    // Freeze Tag Gamemode Info
+    bool isFreezeTagRunner = true;
+    bool isFreezeTagFreeze = false;
+    bool isFreezeTagFallenOff = false; // When runenr falls off and is automatically frozen, this flag is set
+    float freezeIconSize = 0.f;
+    // Puppet Translation Info
+    sead::Vector3f playerPos = sead::Vector3f(0.f,0.f,0.f);
+    sead::Quatf playerRot = sead::Quatf(0.f,0.f,0.f,0.f);
+    // --- Hot: puppet actor control ---
     // Puppet Model Info
-    PlayerAnims::Type curAnim;
-    PlayerAnims::Type curSubAnim;
-    char curAnimStr[PACKBUFSIZE] = {};
-    char curSubAnimStr[PACKBUFSIZE] = {};
+    PlayerAnims::Type curAnim = PlayerAnims::Type::Unknown;
+    PlayerAnims::Type curSubAnim = PlayerAnims::Type::Unknown;
+    CapAnims::Type capAnim = CapAnims::Type::Unknown;
+    bool isCapThrow = false;
+    bool isHoldThrow = false;
     float blendWeights[6] = {};
     float animRate = 0.f;
-    bool is2D = false;
     // Puppet Hack Cap Info
     sead::Vector3f capPos = sead::Vector3f(0.f,0.f,0.f);
     sead::Quatf capRot = sead::Quatf(0.f,0.f,0.f,0.f);
-    char capAnim[PACKBUFSIZE] = {};
-    bool isCapThrow = false;
-    bool isHoldThrow = false;
+    // --- Cold ---
+    // General Puppet Info
+    char puppetName[0x10] = {}; // max user account name size is 10 chars, so this could go down to 0xB
+    nn::account::Uid playerID;
+    // Puppet Stage Info
+    u8 scenarioNo = -1;
+    char stageName[0x40] = {};
+    // Puppet Costume Info
+    CostumeTypes::Type costumeBodyType = CostumeTypes::Type::Unknown;
+    CostumeTypes::Type costumeHeadType = CostumeTypes::Type::Unknown;
+    char costumeBody[0x20] = {}; // name of a costume outside CostumeTypes, never used to load an archive
+    char costumeHead[0x20] = {}; // name of a costume outside CostumeTypes, never used to load an archive
+    // Puppet Capture Info
+    char curHack[0x40] = {};
+    bool isStartCapture = false;
+    char curAnimStr[PACKBUFSIZE] = {};
+    char curSubAnimStr[PACKBUFSIZE] = {};
     // Hide and Seek Gamemode Info
-    bool isIt = false;
     u8 seconds = 0;
     u16 minutes = 0;
     // Freeze Tag Gamemode Info
     uint16_t freezeTagScore = 0;
-    bool isFreezeTagRunner = true;
-    bool isFreezeTagFreeze = false;
-    bool isFreezeTagFallenOff = false; // When runenr falls off and is automatically frozen, this flag is set
-    float freezeIconSize = 0.f;
-};
\ No newline at end of file
+    // Network Sample, copied into the fields above once per frame by Client::syncPuppetInfos
+    SeqLock<PuppetSample> netSample;
+    u32 netSampleSeq = 0;
+};
+
+static_assert(offsetof(PuppetInfo, curAnim) <= 0x40, "per-frame loop fields must fit in the first cache line of PuppetInfo");
+static_assert(offsetof(PuppetInfo, puppetName) <= 0x80, "actor control fields must fit in the second cache line of PuppetInfo");
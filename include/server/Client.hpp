@@ -8,6 +8,8 @@
  */
 #pragma once
 
+#include <atomic>
+
 #include "Keyboard.hpp"
 #include "al/actor/ActorInitInfo.h"
 #include "al/actor/ActorSceneInfo.h"
@@ -45,7 +47,9 @@
 #include "sead/gfx/seadCamera.h"
 #include "sead/basis/seadNew.h"
 #include "sead/container/seadSafeArray.h"
+#include "sead/prim/seadLongBitFlag.h"
 #include "sead/thread/seadMutex.h"
+#include "sead/prim/seadScopedLock.h"
 
 #include "nn/account.h"
 
@@ -57,8 +61,8 @@
 
 #include "logger.hpp"
 #include "server/SocketClient.hpp"
+#include "server/PacketApplyQueue.hpp"
 #include "helpers.hpp"
-#include "puppets/HackModelHolder.hpp"
 #include "puppets/PuppetHolder.hpp"
 #include "syssocket/sockdefines.h"
 #include "debugMenu.hpp"
@@ -66,16 +70,39 @@
 
 #include "puppets/PuppetInfo.h"
 
+#include "algorithms/ShineIndex.h"
+#include "algorithms/UidIndex.h"
+
 #include <cstddef>
 #include <stdlib.h>
 
 #define MAXPUPINDEX 32
 
+static_assert(PacketApplyQueue::cMaxPendingPlayers == MAXPUPINDEX);
+
 struct UIDIndexNode {
     nn::account::Uid uid;
     int puppetIndex;
 };
 
+// running frame time average, used to compare the packet apply modes on the debug menu
+struct FrameTimeStat {
+    void add(float frameMs) {
+        if (frameMs <= 0.f || frameMs > 1000.f)
+            return;  // skip the first frame and scene loads
+        mTotalMs += frameMs;
+        mFrames++;
+        if (frameMs > mMaxMs)
+            mMaxMs = frameMs;
+    }
+    float getAvgMs() const { return mFrames ? (float)(mTotalMs / mFrames) : 0.f; }
+    void reset() { *this = FrameTimeStat(); }
+
+    double mTotalMs = 0.0;
+    u32 mFrames = 0;
+    float mMaxMs = 0.f;
+};
+
 class HideAndSeekIcon;
 
 class Client {
@@ -104,10 +131,19 @@ class Client {
         static void sendCaptureInfPacket(const PlayerActorHakoniwa *player);
         static void sendGamemodePacket();
 
-        int getCollectedShinesCount() { return curCollectedShines.size(); }
-        int getShineID(int index) { if (index < curCollectedShines.size()) { return curCollectedShines[index]; } return -1; }
+        static void update(PlayerActorBase* player);
+        // update doesn't run during a stage load, call this before creating puppets so they init with the latest info
+        static void syncPuppetInfosForInit();
+
+        static bool isBatchApply() { return sInstance ? sInstance->mIsBatchApply.load(std::memory_order_relaxed) : false; }
+
+        static void toggleBatchApply();
+
+        static const FrameTimeStat* getFrameTimeStat(bool isBatchApply) { return sInstance ? &sInstance->mFrameTimes[isBatchApply] : nullptr; }
+
+        static int getLastBatchCount() { return sInstance ? sInstance->mLastBatchCount : 0; }
 
-        static void update();
+        static s64 getLastBatchTime() { return sInstance ? sInstance->mLastBatchTime : 0; }
 
         static void clearArrays();
 
@@ -169,6 +205,8 @@ class Client {
 
         static void setSceneInfo(const al::ActorInitInfo& initInfo, const StageScene *stageScene);
 
+        static void tryBuildShineIndex(GameDataHolderAccessor accessor);
+
         static bool tryRegisterShine(Shine* shine);
 
         static Shine* findStageShine(int shineID);
@@ -192,11 +230,19 @@ class Client {
         SocketClient *mSocket;
 
     private:
+        void applyPacket(Packet *curPacket);
+        void applyPacketBatch();
+        void applyStagedPackets();
+        void stagePacket(Packet *curPacket);
+        void sendPlayerConnectReplies();
+        bool tryAddWarnedCapAnim(const char* actionName);
+        void syncPuppetInfos();
         void updatePlayerInfo(PlayerInf *packet);
         void updateHackCapInfo(HackCapInf *packet);
         void updateGameInfo(GameInf *packet);
         void updateCostumeInfo(CostumeInf *packet);
         void updateShineInfo(ShineCollect *packet);
+        void updateShineSync(ShineSync *packet);
         void updatePlayerConnect(PlayerConnect *packet);
         void updateCaptureInfo(CaptureInf* packet);
         void sendToStage(ChangeStagePacket* packet);
@@ -217,11 +263,27 @@ class Client {
 
         bool mIsConnectionActive = false;
 
+        // when set, the read thread stages received packets in mApplyQueue and the game thread applies them all at the start of the frame
+        std::atomic<bool> mIsBatchApply = false;
+
+        // held by the read thread while it checks the apply mode and stages or applies a packet, and by the game thread
+        // while it applies the staged packets, so packets are never applied by both threads at once
+        sead::Mutex mApplyModeMutex;
+
+        PacketApplyQueue mApplyQueue;
+
+        int mLastBatchCount = 0;
+        s64 mLastBatchTime = 0; // in microseconds
+
+        FrameTimeStat mFrameTimes[2]; // indexed by mIsBatchApply
+
         // --- Server Syncing Members --- 
         
-        // array of shine IDs for checking if multiple shines have been collected in quick sucession, all moons within the players stage that match the ID will be deleted
-        sead::SafeArray<int, 128> curCollectedShines;
-        int collectedShineCount = 0;
+        static constexpr int cMaxShineUid = 0x1000;
+
+        // bit per shine ID collected by other players since the last shine sync, all moons within the players stage that match an ID will be deleted.
+        // set by whichever thread applies packets and taken by updateShines, so every word is only accessed with atomic builtins
+        sead::LongBitFlag<cMaxShineUid> curCollectedShines;
 
         int lastCollectedShine = -1;
 
@@ -253,12 +315,17 @@ class Client {
 
         bool isSentHackInf = false;
 
+        // hashes of cap actions already warned about as missing from CapAnims, cleared every stage
+        static constexpr int cMaxWarnedCapAnims = 16;
+        u32 mWarnedCapAnims[cMaxWarnedCapAnims] = {};
+        int mWarnedCapAnimCount = 0;
+
         al::ActorSceneInfo*
             mSceneInfo  = nullptr;  // TODO: create custom scene info class with only the info we actually need
 
         const StageScene *mCurStageScene = nullptr;
 
-        sead::PtrArray<Shine> mShineArray;  // List of all Shines currently in a Stage
+        ShineIndex<0x800> mShineIndex;  // shine ID to hint info and stage actor, rebuilt every stage
 
         sead::FixedSafeString<0x40> mStageName;
 
@@ -274,6 +341,8 @@ class Client {
         
         PuppetInfo *mPuppetInfoArr[MAXPUPINDEX] = {};
 
+        UidIndex<MAXPUPINDEX * 2> mPuppetIndex; // player id to mPuppetInfoArr slot, updated on connect
+
         PuppetHolder *mPuppetHolder = nullptr;
 
         PuppetInfo mDebugPuppetInfo;
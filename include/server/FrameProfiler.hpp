@@ -0,0 +1,69 @@
+#pragma once
+
+#include "types.h"
+
+// zones timed by the frame profiler, a zone hit multiple times in a frame (e.g. PuppetActor::control) is summed
+enum class ProfileZone : u8 {
+    ClientUpdate,
+    PuppetHolderUpdate,
+    PuppetControl,
+    GameModeUpdate,
+    NameTagUpdate,
+    DrawMain,
+    End
+};
+
+#if PROFILE
+
+#include <atomic>
+#include "sead/time/seadTickTime.h"
+
+struct ProfileSummary {
+    float minUs = 0.f;
+    float avgUs = 0.f;
+    float p99Us = 0.f;
+    float lastUs = 0.f;
+    u32 lastCalls = 0;
+};
+
+class FrameProfiler {
+public:
+    static constexpr int cFrameCount = 256;  // frames kept in the sample ring
+
+    // moves the times accumulated since the last call into the ring, called once at the start of each frame
+    static void beginFrame();
+
+    static void addTime(ProfileZone zone, const sead::TickSpan& span);
+
+    static void calcSummary(ProfileSummary* out, ProfileZone zone);
+
+    static const char* getZoneName(ProfileZone zone);
+
+private:
+    static std::atomic<u32> sCurFrameNs[(int)ProfileZone::End];
+    static std::atomic<u32> sCurFrameCalls[(int)ProfileZone::End];
+    static u32 sFrameNs[(int)ProfileZone::End][cFrameCount];
+    static u32 sFrameCalls[(int)ProfileZone::End];
+    static int sFrameIndex;
+    static int sFramesFilled;
+};
+
+class ScopedProfile {
+public:
+    explicit ScopedProfile(ProfileZone zone) : mZone(zone) {}
+    ~ScopedProfile() { FrameProfiler::addTime(mZone, mStart.diffToNow()); }
+
+private:
+    ProfileZone mZone;
+    sead::TickTime mStart;
+};
+
+#define PROFILE_SCOPE(zone) ScopedProfile profileScope_(zone)
+#define PROFILE_BEGIN_FRAME() FrameProfiler::beginFrame()
+
+#else
+
+#define PROFILE_SCOPE(zone) ((void)0)
+#define PROFILE_BEGIN_FRAME() ((void)0)
+
+#endif
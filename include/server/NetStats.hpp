@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include "packets/Packet.h"
+#include "types.h"
+
+// counters for a single packet type, updated with relaxed atomics from any thread
+struct PacketTypeStats {
+    std::atomic<u32> packetsIn = 0;
+    std::atomic<u32> bytesIn = 0;
+    std::atomic<u32> packetsOut = 0;
+    std::atomic<u32> bytesOut = 0;
+    std::atomic<u32> drops = 0;
+};
+
+enum class NetDropReason : u8 {
+    RecvQueueFull,
+    SendQueueFull,
+    NotConnected,
+    SendFailed,
+    InvalidHeader,
+    Truncated,
+    End
+};
+
+enum class NetQueue : u8 {
+    Recv,
+    Send,
+    Apply,
+    End
+};
+
+// per packet type network telemetry. writers only use atomic increments, the sliding window rates and
+// the periodic log dump are calculated on the game thread by update
+class NetStats {
+public:
+    static constexpr int cWindowSeconds = 5;
+    static constexpr int cDumpIntervalSeconds = 10;
+
+    static void recordRecv(PacketType type, u32 size);
+    static void recordSend(PacketType type, u32 size);
+    static void recordDrop(PacketType type, NetDropReason reason);
+    static void recordQueueCount(NetQueue queue, u32 count);
+    static void recordReconnect(bool isSuccess);
+
+    static void update();
+    static void dumpToLog();
+
+    static const PacketTypeStats& getStats(PacketType type) { return sTypeStats[toIndex(type)]; }
+    static float getRateIn(PacketType type) { return sRateIn[toIndex(type)]; }
+    static float getRateOut(PacketType type) { return sRateOut[toIndex(type)]; }
+    static u32 getDropCount(NetDropReason reason) { return sDrops[(int)reason].load(std::memory_order_relaxed); }
+    static u32 getQueueHighWater(NetQueue queue) { return sQueueHighWater[(int)queue].load(std::memory_order_relaxed); }
+    static u32 getReconnectCount() { return sReconnects.load(std::memory_order_relaxed); }
+    static u32 getReconnectFailCount() { return sReconnectFails.load(std::memory_order_relaxed); }
+
+    static const char* getDropReasonName(NetDropReason reason);
+    static const char* getQueueName(NetQueue queue);
+
+    static bool isPeriodicDump() { return sIsPeriodicDump; }
+    static void togglePeriodicDump() { sIsPeriodicDump = !sIsPeriodicDump; }
+
+private:
+    static int toIndex(PacketType type) { return type > PacketType::UNKNOWN && type < PacketType::End ? type : PacketType::UNKNOWN; }
+
+    static PacketTypeStats sTypeStats[PacketType::End];
+    static std::atomic<u32> sDrops[(int)NetDropReason::End];
+    static std::atomic<u32> sQueueHighWater[(int)NetQueue::End];
+    static std::atomic<u32> sReconnects;
+    static std::atomic<u32> sReconnectFails;
+
+    // game thread only
+    static u32 sWindowIn[cWindowSeconds + 1][PacketType::End];
+    static u32 sWindowOut[cWindowSeconds + 1][PacketType::End];
+    static int sWindowIndex;
+    static int sWindowFilled;
+    static u64 sLastSampleTick;
+    static int sSecondsSinceDump;
+    static float sRateIn[PacketType::End];
+    static float sRateOut[PacketType::End];
+    static bool sIsPeriodicDump;
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "packets/Packet.h"
+#include "types.h"
+
+// packets staged by the read thread in batch apply mode until the game thread applies them. nothing is dropped while
+// the game thread isn't draining it (scene loads), the list grows instead. a PLAYERINF or HACKCAPINF from a player
+// that already has one waiting is copied over the waiting packet, so a long load only holds the latest movement state
+// per player and the rest of the packets keep their order. not thread safe by itself, Client guards it with a mutex.
+class PacketApplyQueue {
+public:
+    static constexpr int cInitialCapacity = 0x80;
+    static constexpr int cMaxPendingPlayers = 32;  // MAXPUPINDEX
+
+    ~PacketApplyQueue();
+
+    // takes ownership of the packet, false if the list couldn't grow in which case the caller still owns it
+    bool push(Packet* packet);
+    // stops coalescing into the packets already staged for a player, used on PLAYERDC so state sent after a
+    // reconnect isn't applied ahead of the disconnect
+    void forgetPlayer(const nn::account::Uid& userID);
+
+    int getCount() const { return mCount; }
+    Packet* get(int index) const { return mPackets[index]; }
+    // forgets every staged packet, the caller has to apply or free them first
+    void clear();
+
+    u32 getCoalesceCount() const { return mCoalesceCount; }
+
+private:
+    // the staged movement packets of one player
+    struct Pending {
+        nn::account::Uid userID;
+        Packet* playerInf;
+        Packet* hackCapInf;
+    };
+
+    bool tryCoalesce(Packet* packet);
+    bool tryGrow();
+
+    Packet** mPackets = nullptr;
+    int mCount = 0;
+    int mCapacity = 0;
+
+    Pending mPending[cMaxPendingPlayers];
+    int mPendingCount = 0;
+
+    u32 mCoalesceCount = 0;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "types.h"
+
+class PlayerActorBase;
+class PuppetActor;
+
+// per puppet results of PuppetQuery, indexed the same as PuppetHolder and Client::getPuppetInfo
+struct PuppetQueryResult {
+    float distSq = 0.f;       // player to the puppet's network position (PuppetInfo::playerPos)
+    float dist = 0.f;
+    float modelDistSq = 0.f;  // player to the puppet's current model, which lags behind the network position
+    float modelDist = 0.f;
+    float cameraDistSq = 0.f; // camera to the puppet's current model, used for PuppetActor's LOD
+    bool isActive = false;    // connected and in the same stage
+    bool isSame2D = false;    // puppet is2D matches the player's 2D model state
+};
+
+// player to puppet proximity, calculated once per frame in Client::update so the game modes and name tags don't each
+// loop over every puppet calling al::calcDistance. positions are gathered into flat arrays first so the distance
+// pass can run through the batch math kernels.
+class PuppetQuery {
+public:
+    static constexpr int cMaxPuppets = 32;  // MAXPUPINDEX
+
+    static void update(PlayerActorBase* player);
+
+    // false if there was no player this frame, in which case every result is inactive
+    static bool isValid() { return sIsValid; }
+    static int getCount() { return sCount; }
+    // incremented every update, used to spread throttled work over frames
+    static u32 getFrameCount() { return sFrameCount; }
+    // out of range indices and invalid frames get an inactive result that is never near anything
+    static const PuppetQueryResult& get(int index) { return sIsValid && index >= 0 && index < sCount ? sResults[index] : sEmptyResult; }
+    static const PuppetQueryResult& get(const PuppetActor* puppet);
+
+    static bool isNear(int index, float dist) { return get(index).distSq < dist * dist; }
+    static bool isModelNear(const PuppetActor* puppet, float dist) { return get(puppet).modelDistSq < dist * dist; }
+
+private:
+    static bool sIsValid;
+    static int sCount;
+    static u32 sFrameCount;
+    static PuppetQueryResult sResults[cMaxPuppets];
+    static PuppetQueryResult sEmptyResult;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "al/async/AsyncFunctorThread.h"
+#include "al/async/FunctorBase.h"
+#include "types.h"
+
+#include <atomic>
+
+// every thread the mod creates, in the order they are shown in the server config menu
+enum class NetThread : u8 {
+    SocketRecv,
+    SocketSend,
+    ClientRead,
+    LogFlush,
+    End
+};
+
+struct ThreadSettings {
+    s32 priority;   // nn::os priority (0 highest, 31 lowest), cDefaultPriority keeps the priority the thread was created with
+    u64 coreMask;   // 0 keeps the core mask the thread was created with
+    s32 stackSize;  // only used when the thread is created
+};
+
+// runtime state tracked for each thread, only touched by the thread itself except for the cpu usage readout
+struct ThreadState {
+    u32 appliedGeneration = 0;
+    bool isDefaultsSaved = false;
+    s32 defaultPriority = 0;
+    s32 defaultIdealCore = 0;
+    u64 defaultCoreMask = 0;
+    u64 lastCpuTicks = 0;
+    u64 lastSampleTick = 0;
+    u64 totalCpuTicks = 0;
+    float cpuUsage = 0.f;  // percentage of one core used during the last sample window
+};
+
+class ThreadConfig {
+public:
+    static constexpr s32 cDefaultPriority = -1;
+
+    static constexpr int cPriorityPresetCount = 4;
+    static constexpr int cCoreMaskPresetCount = 5;
+
+    static al::AsyncFunctorThread* createThread(NetThread thread, const al::FunctorBase& functor);
+
+    // called at the top of each thread's loop, applies changed settings to the calling thread and samples its cpu time if measuring
+    static void updateCurrentThread(NetThread thread);
+
+    static const char* getName(NetThread thread);
+    static const ThreadSettings& getSettings(NetThread thread) { return sSettings[(int)thread]; }
+    static const ThreadState& getState(NetThread thread) { return sStates[(int)thread]; }
+
+    static void setPriority(NetThread thread, s32 priority);
+    static void setCoreMask(NetThread thread, u64 coreMask);
+
+    // cycles through a small set of presets, used by the server config menu
+    static void cyclePriority(NetThread thread);
+    static void cycleCoreMask(NetThread thread);
+
+    static void getPriorityString(char* out, size_t size, s32 priority);
+    static void getCoreMaskString(char* out, size_t size, u64 coreMask);
+
+    static bool isMeasureCpuTime() { return sIsMeasureCpuTime; }
+    static void setMeasureCpuTime(bool value);
+
+    static float getCpuTimeMs(NetThread thread);
+
+private:
+    static ThreadSettings sSettings[(int)NetThread::End];
+    static ThreadState sStates[(int)NetThread::End];
+    static std::atomic<u32> sGeneration;
+    static bool sIsMeasureCpuTime;
+};
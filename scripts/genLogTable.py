@@ -0,0 +1,48 @@
+import json
+import os
+import re
+import sys
+import zlib
+
+# Collects the format strings of every LOG_* call so scripts/tcpServer.py can decode binary logs (LOG_BINARY=1).
+# Usage: genLogTable.py <output.json> <source dirs...>
+
+LOG_CALL = re.compile(r'\bLOG_(?:TRACE|DEBUG|INFO|WARN|ERROR)\s*\(\s*\w+\s*,\s*((?:"(?:\\.|[^"\\])*"\s*)+)')
+LOG_AT_CALL = re.compile(r'\bLOG_AT\s*\(\s*\w+\s*,\s*\w+\s*,\s*((?:"(?:\\.|[^"\\])*"\s*)+)')
+STRING_LITERAL = re.compile(r'"((?:\\.|[^"\\])*)"')
+
+# the hash has to match crc32::HashStr, which is the standard crc32
+def hashStr(fmt):
+    return zlib.crc32(fmt.encode('utf-8')) & 0xFFFFFFFF
+
+def unescape(literal):
+    return literal.encode('latin-1', 'backslashreplace').decode('unicode_escape')
+
+def collect(dirs):
+    table = {}
+    for root in dirs:
+        for dirPath, _, files in os.walk(root):
+            for file in files:
+                if not file.endswith(('.cpp', '.h', '.hpp')):
+                    continue
+                path = os.path.join(dirPath, file)
+                with open(path, encoding='utf-8', errors='replace') as f:
+                    src = f.read()
+                for match in list(LOG_CALL.finditer(src)) + list(LOG_AT_CALL.finditer(src)):
+                    fmt = ''.join(unescape(s) for s in STRING_LITERAL.findall(match.group(1)))
+                    key = f'{hashStr(fmt):08X}'
+                    if key in table and table[key] != fmt:
+                        sys.exit(f'Log format hash collision between "{table[key]}" and "{fmt}" ({path})')
+                    table[key] = fmt
+    return table
+
+if __name__ == '__main__':
+    if len(sys.argv) < 3:
+        sys.exit(f'Usage: {sys.argv[0]} <output.json> <source dirs...>')
+
+    table = collect(sys.argv[2:])
+
+    with open(sys.argv[1], 'w') as f:
+        json.dump(table, f, indent=1, sort_keys=True)
+
+    print(f'Wrote {len(table)} log format strings to {sys.argv[1]}.')
@@ -1,15 +1,134 @@
+import json
+import re
 import socket
+import struct
 import sys
+from datetime import datetime
 
 # Super simple TCP server yoinked straight from google.com (http://pymotw.com/2/socket/tcp.html)
+# Usage: tcpServer.py <ip> [port] [log table json from scripts/genLogTable.py, needed for LOG_BINARY builds]
 
 # Create a TCP/IP socket
 sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
 
 port = 3080
-if len(sys.argv) == 3:
+if len(sys.argv) >= 3:
     port = int(sys.argv[2])
 
+logTable = {}
+if len(sys.argv) >= 4:
+    with open(sys.argv[3]) as f:
+        logTable = json.load(f)
+    print(f"Loaded {len(logTable)} log format strings.")
+
+# binary log stream layout, see include/logger.hpp
+BINARY_MAGIC = b'SMOLOGB1'
+RECORD_HEADER = struct.Struct('<HBBIQ')  # size, type, levelCategory, fmtHash, tick
+RECORD_FORMAT, RECORD_TEXT, RECORD_NAME = range(3)
+LEVEL_NAMES = ['TRACE', 'DEBUG', 'INFO', 'WARN', 'ERROR']
+CATEGORY_NAMES = ['General', 'Net', 'Puppet', 'GameMode', 'Boot', 'Menu']
+
+PRINTF_SPEC = re.compile(r'%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l|z|j|t|L)?([diouxXeEfFgGcspa%])')
+
+def readArgs(data):
+    args = []
+    pos = 0
+    while pos < len(data):
+        tag = data[pos]
+        pos += 1
+        if tag == 0:
+            args.append(struct.unpack_from('<i', data, pos)[0])
+            pos += 4
+        elif tag == 1 or tag == 4:
+            args.append(struct.unpack_from('<q' if tag == 1 else '<Q', data, pos)[0])
+            pos += 8
+        elif tag == 2:
+            args.append(struct.unpack_from('<d', data, pos)[0])
+            pos += 8
+        elif tag == 3:
+            length = struct.unpack_from('<H', data, pos)[0]
+            args.append(data[pos + 2:pos + 2 + length].decode('utf-8', 'replace'))
+            pos += 2 + length
+        else:
+            break
+    return args
+
+# converts a C format string to python % formatting and applies the args
+def formatArgs(fmt, args):
+    out = []
+    argIndex = 0
+    last = 0
+    for match in PRINTF_SPEC.finditer(fmt):
+        out.append(fmt[last:match.start()])
+        last = match.end()
+        flags, length, conv = match.groups()
+        if conv == '%':
+            out.append('%')
+            continue
+        if argIndex >= len(args):
+            out.append(match.group(0))
+            continue
+        arg = args[argIndex]
+        argIndex += 1
+        try:
+            if conv == 'p':
+                out.append(f'0x{arg:x}')
+            elif conv == 'a':
+                out.append(float(arg).hex())
+            elif conv == 'c':
+                out.append(chr(arg & 0xFF))
+            else:
+                if conv in 'uxXo' and isinstance(arg, int) and arg < 0:
+                    arg &= 0xFFFFFFFFFFFFFFFF if length in ('l', 'll', 'z', 'j', 't') else 0xFFFFFFFF
+                out.append(('%' + flags + conv) % arg)
+        except (TypeError, ValueError):
+            out.append(f'<{match.group(0)}:{arg!r}>')
+    out.append(fmt[last:])
+    return ''.join(out)
+
+class BinaryLogDecoder:
+    def __init__(self, tickFrequency):
+        self.tickFrequency = tickFrequency
+        self.name = ''
+        self.isLineStart = True
+
+    def printText(self, text, tick, levelCategory):
+        seconds = tick / self.tickFrequency
+        level = levelCategory >> 4
+        category = levelCategory & 0xF
+        for line in text.splitlines(keepends=True):
+            if self.isLineStart:
+                now = datetime.now().strftime('%H:%M:%S.%f')[:-3]
+                levelName = LEVEL_NAMES[level] if level < len(LEVEL_NAMES) else '?'
+                categoryName = CATEGORY_NAMES[category] if category < len(CATEGORY_NAMES) else '?'
+                print(f'{now} [{seconds:10.4f}] {levelName:5} {categoryName:8} [{self.name}] ', end='')
+            print(line, end='', flush=True)
+            self.isLineStart = line.endswith('\n')
+
+    # returns how many bytes of data were consumed
+    def feed(self, data):
+        pos = 0
+        while len(data) - pos >= RECORD_HEADER.size:
+            size, recordType, levelCategory, fmtHash, tick = RECORD_HEADER.unpack_from(data, pos)
+            if len(data) - pos - RECORD_HEADER.size < size:
+                break
+            payload = data[pos + RECORD_HEADER.size:pos + RECORD_HEADER.size + size]
+            pos += RECORD_HEADER.size + size
+
+            if recordType == RECORD_NAME:
+                self.name = payload.decode('utf-8', 'replace')
+            elif recordType == RECORD_TEXT:
+                self.printText(payload.decode('utf-8', 'replace'), tick, levelCategory)
+            elif recordType == RECORD_FORMAT:
+                args = readArgs(payload)
+                fmt = logTable.get(f'{fmtHash:08X}')
+                if fmt is None:
+                    text = f'<unknown format {fmtHash:08X}> {args}\n'
+                else:
+                    text = formatArgs(fmt, args)
+                self.printText(text, tick, levelCategory)
+        return pos
+
 # Bind the socket to the port
 server_address = (sys.argv[1], port)
 print(f"Starting TCP Server with IP {server_address[0]} and Port {server_address[1]}.")
@@ -24,19 +143,40 @@ while True:
     connection, client_address = sock.accept()
     try:
         print(f'Switch Connected! IP: {client_address[0]} Port: {client_address[1]}')
+        pending = b''
+        decoder = None
+        isText = False
         while True:
-            data = connection.recv(1024)
+            data = connection.recv(4096)
 
-            if data:
-                print(data.decode("utf-8"), end='', flush=True)
-            else:
+            if not data:
                 print(f'Connection Terminated.')
                 break
 
+            if isText:
+                print(data.decode("utf-8", "replace"), end='', flush=True)
+                continue
+
+            pending += data
+
+            # text builds never send the magic, so the first bytes decide how the stream is read
+            if decoder is None:
+                if len(pending) < len(BINARY_MAGIC) + 8 and BINARY_MAGIC.startswith(pending[:len(BINARY_MAGIC)]):
+                    continue
+                if not pending.startswith(BINARY_MAGIC):
+                    isText = True
+                    print(pending.decode("utf-8", "replace"), end='', flush=True)
+                    continue
+                tickFrequency = struct.unpack_from('<Q', pending, len(BINARY_MAGIC))[0]
+                decoder = BinaryLogDecoder(tickFrequency)
+                pending = pending[len(BINARY_MAGIC) + 8:]
+                print(f'Binary log stream, tick frequency {tickFrequency} Hz.')
+
+            pending = pending[decoder.feed(pending):]
+
     except ConnectionResetError:
         print("Connection reset")
 
     finally:
         # Clean up the connection
         connection.close()
-
@@ -1,5 +1,6 @@
 #include "helpers.hpp"
 #include "al/LiveActor/LiveActor.h"
+#include "al/string/StringTmp.h"
 #include "logger.hpp"
 #include "sead/math/seadMathCalcCommon.h"
 #include "sead/math/seadQuat.h"
@@ -70,11 +71,11 @@ sead::Vector3f QuatToEuler(sead::Quatf *quat) {
 }
 
 void logVector(const char *vectorName, sead::Vector3f vector) {
-    Logger::log("%s: \nX: %f\nY: %f\nZ: %f\n", vectorName, vector.x, vector.y, vector.z);
+    LOG_DEBUG(General, "%s: \nX: %f\nY: %f\nZ: %f\n", vectorName, vector.x, vector.y, vector.z);
 }
 
 void logQuat(const char *quatName, sead::Quatf &quat) {
-    Logger::log("%s: \nX: %f\nY: %f\nZ: %f\nW: %f\n", quatName, quat.x, quat.y, quat.z, quat.w);
+    LOG_DEBUG(General, "%s: \nX: %f\nY: %f\nZ: %f\nW: %f\n", quatName, quat.x, quat.y, quat.z, quat.w);
 }
 
 float vecMagnitude(sead::Vector3f const &input) {
@@ -93,26 +94,20 @@ float quatAngle(sead::Quatf const &q1, sead::Quatf &q2) {
 }
 
 bool isInCostumeList(const char *costumeName) {
-    for (size_t i = 0; i < sizeof(costumeNames)/sizeof(costumeNames[0]); i++)
-    {
-        if(al::isEqualString(costumeNames[i], costumeName)) {
-            return true;
-        }
-    }
-    return false;
+    return CostumeTypes::FindType(costumeName) != CostumeTypes::Type::Unknown;
 }
 
 const char *tryGetPuppetCapName(PuppetInfo *info) {
-    if(info->costumeHead && isInCostumeList(info->costumeHead)) {
-        return info->costumeHead;
+    if(info->costumeHeadType != CostumeTypes::Type::Unknown) {
+        return CostumeTypes::FindStr(info->costumeHeadType);
     }else {
         return "Mario";
     }
 }
 
 const char *tryGetPuppetBodyName(PuppetInfo *info) {
-    if(info->costumeBody && isInCostumeList(info->costumeBody)) {
-        return info->costumeBody;
+    if(info->costumeBodyType != CostumeTypes::Type::Unknown) {
+        return CostumeTypes::FindStr(info->costumeBodyType);
     }else {
         return "Mario";
     }
@@ -235,6 +235,5 @@ void updateDrawHook(al::ExecuteDirector* thisPtr, const char* listName, const ch
     
     thisPtr->drawList("OnlineDrawExecutors", "PuppetActor");
 
-    Logger::log("Updating Draw List for: %s %s\n", listName, kit);
     thisPtr->drawList(listName, kit);
 }
\ No newline at end of file
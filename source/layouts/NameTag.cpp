@@ -6,6 +6,8 @@
 #include "al/util/NerveUtil.h"
 #include "logger.hpp"
 #include "sead/math/seadVector.h"
+#include "server/FrameProfiler.hpp"
+#include "server/PuppetQuery.hpp"
 #include "server/freeze/FreezeTagMode.hpp"
 #include "server/gamemode/GameModeManager.hpp"
 
@@ -73,7 +75,9 @@ void NameTag::updateTrans() {
 
     al::setLocalTrans(this, newTrans);
 
-    mNormalizedDist = 1 - al::normalize(al::calcDistance(puppetModel, al::getPlayerActor(puppetModel, 0)), 200.0f, mEndDist);
+    float dist = isTrackedByQuery() ? PuppetQuery::get(mPuppet).modelDist : al::calcDistance(puppetModel, al::getPlayerActor(puppetModel, 0));
+
+    mNormalizedDist = 1 - al::normalize(dist, 200.0f, mEndDist);
     
     //Freeze tag exclusive name tag distance changes
     if(GameModeManager::instance()->isModeAndActive(GameMode::FREEZETAG)) {
@@ -86,6 +90,7 @@ void NameTag::updateTrans() {
 }
 
 void NameTag::update() {
+    PROFILE_SCOPE(ProfileZone::NameTagUpdate);
 
     if (al::isNerve(this, &nrvNameTagEnd) || al::isNerve(this, &nrvNameTagHide) || !mIsAlive) {
         if (isNearPlayerActor(mStartDist)) {
@@ -116,9 +121,17 @@ bool NameTag::isNearPlayerActor(float dist) const {
     if(mPuppet->getInfo()->isFreezeTagFreeze)
         return true;
     
+    if (isTrackedByQuery())
+        return PuppetQuery::isModelNear(mPuppet, dist);
+
     return al::isNearPlayer(mPuppet->getCurrentModel(), dist);
 }
 
+// the debug puppet isn't in the puppet holder, so it falls back to measuring the distance itself
+bool NameTag::isTrackedByQuery() const {
+    return PuppetQuery::isValid() && mPuppet->getPuppetIndex() >= 0;
+}
+
 bool NameTag::isVisible() const {
     return isNearPlayerActor(mStartDist);
 }
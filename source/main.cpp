@@ -13,6 +13,7 @@
 #include "heap/seadHeap.h"
 #include "math/seadVector.h"
 #include "server/Client.hpp"
+#include "puppets/CaptureActorPool.hpp"
 #include "puppets/PuppetInfo.h"
 #include "actors/PuppetActor.h"
 #include "al/LiveActor/LiveActor.h"
@@ -35,6 +36,9 @@
 #include "server/gamemode/GameModeBase.hpp"
 #include "server/hns/HideAndSeekMode.hpp"
 #include "server/gamemode/GameModeManager.hpp"
+#include "server/FrameProfiler.hpp"
+#include "server/NetStats.hpp"
+#include "server/ThreadConfig.hpp"
 
 static int pInfSendTimer = 0;
 static int gameInfSendTimer = 0;
@@ -75,10 +79,12 @@ int debugPuppetIndex = 0;
 int debugCaptureIndex = 0;
 static int pageIndex = 0;
 
-static const int maxPages = 3;
+static const int maxPages = 6;
 
 void drawMainHook(HakoniwaSequence *curSequence, sead::Viewport *viewport, sead::DrawContext *drawContext) {
 
+    PROFILE_SCOPE(ProfileZone::DrawMain);
+
     // sead::FrameBuffer *frameBuffer;
     // __asm ("MOV %[result], X21" : [result] "=r" (frameBuffer));
 
@@ -133,6 +139,7 @@ void drawMainHook(HakoniwaSequence *curSequence, sead::Viewport *viewport, sead:
     
     gTextWriter->printf("Send Queue Count: %d/%d\n", Client::instance()->mSocket->getSendCount(), Client::instance()->mSocket->getSendMaxCount());
     gTextWriter->printf("Recv Queue Count: %d/%d\n", Client::instance()->mSocket->getRecvCount(), Client::instance()->mSocket->getRecvMaxCount());
+    gTextWriter->printf("Capture Actors Leased: %d/%d\n", CaptureActorPool::getLeasedCount(), CaptureActorPool::getActorCount());
     
     if(GameModeManager::instance()->isModeAndActive(GameMode::FREEZETAG)) {
         FreezeTagInfo* inf = GameModeManager::instance()->getInfo<FreezeTagInfo>();
@@ -184,8 +191,9 @@ void drawMainHook(HakoniwaSequence *curSequence, sead::Viewport *viewport, sead:
                         gTextWriter->printf("Is in Capture: %s\n", curPupInfo->isCaptured ? "True" : "False");
                         gTextWriter->printf("Puppet Stage: %s\n", curPupInfo->stageName);
                         gTextWriter->printf("Puppet Scenario: %u\n", curPupInfo->scenarioNo);
-                        gTextWriter->printf("Puppet Costume: H: %s B: %s\n", curPupInfo->costumeHead, curPupInfo->costumeBody);
+                        gTextWriter->printf("Puppet Costume: H: %s B: %s\n", tryGetPuppetCapName(curPupInfo), tryGetPuppetBodyName(curPupInfo));
                         gTextWriter->printf("Puppet Team/Freeze State: %s/%s\n", BTOC(curPupInfo->isFreezeTagRunner), BTOC(curPupInfo->isFreezeTagFreeze));
+                        gTextWriter->printf("Puppet LOD: %d (0 = Full, 2 = Minimal)\n", (int)curPuppet->getLod());
                         //gTextWriter->printf("Packet Coords:\nX: %f\nY: %f\nZ: %f\n", curPupInfo->playerPos.x, curPupInfo->playerPos.y, curPupInfo->playerPos.z);
 
                         if(curPupInfo->isCaptured) {
@@ -254,6 +262,80 @@ void drawMainHook(HakoniwaSequence *curSequence, sead::Viewport *viewport, sead:
                 }
             }
             
+            }
+            break;
+        case 3:
+            {
+                const FrameTimeStat* immediateTimes = Client::getFrameTimeStat(false);
+                const FrameTimeStat* batchTimes = Client::getFrameTimeStat(true);
+
+                gTextWriter->printf("Packet Apply Mode: %s (ZL + Up to toggle)\n", Client::isBatchApply() ? "Batched" : "Immediate");
+
+                if (immediateTimes && batchTimes) {
+                    gTextWriter->printf("Immediate Frame Time: Avg %.3fms Max %.3fms (%u frames)\n", immediateTimes->getAvgMs(), immediateTimes->mMaxMs, immediateTimes->mFrames);
+                    gTextWriter->printf("Batched Frame Time: Avg %.3fms Max %.3fms (%u frames)\n", batchTimes->getAvgMs(), batchTimes->mMaxMs, batchTimes->mFrames);
+                }
+
+                gTextWriter->printf("Last Batch: %d packets in %ldus\n", Client::getLastBatchCount(), Client::getLastBatchTime());
+
+                if (ThreadConfig::isMeasureCpuTime()) {
+                    for (int i = 0; i < (int)NetThread::End; i++) {
+                        const ThreadState& state = ThreadConfig::getState(static_cast<NetThread>(i));
+                        gTextWriter->printf("%s CPU: %.2f%% (%.1fms total)\n", ThreadConfig::getName(static_cast<NetThread>(i)), state.cpuUsage, ThreadConfig::getCpuTimeMs(static_cast<NetThread>(i)));
+                    }
+                } else {
+                    gTextWriter->printf("Thread CPU Time Measurement is disabled in the Server Config.\n");
+                }
+            }
+            break;
+        case 4:
+            {
+                gTextWriter->printf("Periodic Log Dump: %s (ZL + Down to toggle)\n", BTOC(NetStats::isPeriodicDump()));
+
+                for (int i = 0; i < PacketType::End; i++) {
+                    PacketType type = static_cast<PacketType>(i);
+                    const PacketTypeStats& stats = NetStats::getStats(type);
+
+                    u32 packetsIn = stats.packetsIn.load(std::memory_order_relaxed);
+                    u32 packetsOut = stats.packetsOut.load(std::memory_order_relaxed);
+                    u32 drops = stats.drops.load(std::memory_order_relaxed);
+
+                    if (!packetsIn && !packetsOut && !drops)
+                        continue;
+
+                    gTextWriter->printf("%s: In %u %.1f/s %.1fKB Out %u %.1f/s %.1fKB Drop %u\n", packetNames[i],
+                                        packetsIn, NetStats::getRateIn(type), stats.bytesIn.load(std::memory_order_relaxed) * 0.001f,
+                                        packetsOut, NetStats::getRateOut(type), stats.bytesOut.load(std::memory_order_relaxed) * 0.001f,
+                                        drops);
+                }
+
+                gTextWriter->printf("Drops: RecvFull %u SendFull %u NotConn %u SendFail %u BadHeader %u Truncated %u\n",
+                                    NetStats::getDropCount(NetDropReason::RecvQueueFull), NetStats::getDropCount(NetDropReason::SendQueueFull),
+                                    NetStats::getDropCount(NetDropReason::NotConnected), NetStats::getDropCount(NetDropReason::SendFailed),
+                                    NetStats::getDropCount(NetDropReason::InvalidHeader), NetStats::getDropCount(NetDropReason::Truncated));
+                gTextWriter->printf("Queue High Water: Recv %u Send %u Apply %u\n", NetStats::getQueueHighWater(NetQueue::Recv),
+                                    NetStats::getQueueHighWater(NetQueue::Send), NetStats::getQueueHighWater(NetQueue::Apply));
+                gTextWriter->printf("Reconnects: %u (%u failed)\n", NetStats::getReconnectCount(), NetStats::getReconnectFailCount());
+                gTextWriter->printf("Log Output: %s Messages Dropped: %u\n", Logger::getOutputName(), Logger::getDropCount());
+                gTextWriter->printf("Log Level: %s (ZR + Down to cycle) Categories: 0x%X\n", Logger::getLevelName(Logger::getMinLevel()), Logger::getCategoryMask());
+            }
+            break;
+        case 5:
+            {
+#if PROFILE
+                gTextWriter->printf("Frame Profiler (last %d frames, us)\n", FrameProfiler::cFrameCount);
+
+                for (int i = 0; i < (int)ProfileZone::End; i++) {
+                    ProfileSummary summary;
+                    FrameProfiler::calcSummary(&summary, static_cast<ProfileZone>(i));
+
+                    gTextWriter->printf("%s: Min %.1f Avg %.1f P99 %.1f Last %.1f (%u calls)\n",
+                                        FrameProfiler::getZoneName(static_cast<ProfileZone>(i)), summary.minUs,
+                                        summary.avgUs, summary.p99Us, summary.lastUs, summary.lastCalls);
+                }
+#else
+                gTextWriter->printf("Frame Profiler is disabled, build with PROFILE=1 to enable it.\n");
+#endif
             }
             break;
         default:
@@ -315,6 +397,8 @@ void stageInitHook(al::ActorInitInfo *info, StageScene *curScene, al::PlacementI
 
     Client::sendGameInfPacket(info->mActorSceneInfo.mSceneObjHolder);
 
+    Logger::requestFileFlush();
+
 }
 
 PlayerCostumeInfo *setPlayerModel(al::LiveActor *player, const al::ActorInitInfo &initInfo, const char *bodyModel, const char *capModel, al::AudioKeeper *keeper, bool isCloset) {
@@ -356,6 +440,8 @@ bool hakoniwaSequenceHook(HakoniwaSequence* sequence) {
 
     bool isFirstStep = al::isFirstStep(sequence);
 
+    PROFILE_BEGIN_FRAME();
+
     al::PlayerHolder *pHolder = al::getScenePlayerHolder(stageScene);
     PlayerActorBase* playerBase = al::tryGetPlayerActor(pHolder, 0);
     
@@ -366,7 +452,7 @@ bool hakoniwaSequenceHook(HakoniwaSequence* sequence) {
     GameModeManager::instance()->setPaused(stageScene->isPause());
     Client::setStageInfo(stageScene->mHolder);
 
-    Client::update();
+    Client::update(playerBase);
 
     updatePlayerInfo(stageScene->mHolder, playerBase, isYukimaru);
 
@@ -376,6 +462,7 @@ bool hakoniwaSequenceHook(HakoniwaSequence* sequence) {
         if (al::isPadTriggerUp(-1)) debugMode = !debugMode;
         if (al::isPadTriggerLeft(-1)) pageIndex--;
         if (al::isPadTriggerRight(-1)) pageIndex++;
+        if (debugMode && al::isPadTriggerDown(-1)) Logger::cycleMinLevel();
         if(pageIndex < 0) {
             pageIndex = maxPages - 1;
         }
@@ -386,6 +473,8 @@ bool hakoniwaSequenceHook(HakoniwaSequence* sequence) {
         if (debugMode) {
             if (al::isPadTriggerLeft(-1)) debugPuppetIndex--;
             if (al::isPadTriggerRight(-1)) debugPuppetIndex++;
+            if (al::isPadTriggerUp(-1)) Client::toggleBatchApply();
+            if (al::isPadTriggerDown(-1)) NetStats::togglePeriodicDump();
 
             if(debugPuppetIndex < 0) {
                 debugPuppetIndex = Client::getMaxPlayerCount() - 2;
@@ -452,10 +541,13 @@ bool hakoniwaSequenceHook(HakoniwaSequence* sequence) {
 
 void seadPrintHook(const char *fmt, ...)
 {
-    va_list args;
-	va_start(args, fmt);
+    // engine prints are filtered like LOG_DEBUG(General, ...), so release builds compile them out
+    if constexpr (Logger::isCompiled(LogLevel::Debug, LogCategory::General)) {
+        va_list args;
+        va_start(args, fmt);
 
-    Logger::log(fmt, args);
+        Logger::log(LogLevel::Debug, LogCategory::General, fmt, args);
 
-    va_end(args);
+        va_end(args);
+    }
 }
\ No newline at end of file
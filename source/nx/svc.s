@@ -14,4 +14,12 @@
 SVC_BEGIN svcOutputDebugString
 	svc 0x27
 	ret
-SVC_END
\ No newline at end of file
+SVC_END
+
+SVC_BEGIN svcGetInfo
+	str x0, [sp, #-16]!
+	svc 0x29
+	ldr x2, [sp], #16
+	str x1, [x2]
+	ret
+SVC_END
@@ -0,0 +1,79 @@
+#include "puppets/CaptureActorPool.hpp"
+#include <cstring>
+#include "actors/PuppetHackActor.h"
+#include "al/util.hpp"
+
+CaptureActorPool::Entry CaptureActorPool::sEntries[cMaxActors];
+int CaptureActorPool::sCount = 0;
+
+void CaptureActorPool::reset() {
+    sCount = 0;
+}
+
+int CaptureActorPool::getTypeCount(const char* hackName) {
+    int count = 0;
+
+    for (int i = 0; i < sCount; i++) {
+        if (al::isEqualString(sEntries[i].hackName, hackName)) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+bool CaptureActorPool::addActor(PuppetHackActor* actor, const char* hackName) {
+    if (sCount >= cMaxActors) {
+        return false;
+    }
+
+    Entry& entry = sEntries[sCount++];
+    entry.actor = actor;
+    entry.isLeased = false;
+    strncpy(entry.hackName, hackName, sizeof(entry.hackName) - 1);
+    entry.hackName[sizeof(entry.hackName) - 1] = '\0';
+
+    return true;
+}
+
+PuppetHackActor* CaptureActorPool::lease(const char* hackName, PuppetInfo* info) {
+    for (int i = 0; i < sCount; i++) {
+        Entry& entry = sEntries[i];
+
+        if (!entry.isLeased && al::isEqualString(entry.hackName, hackName)) {
+            entry.isLeased = true;
+            entry.actor->setPuppetInfo(info);
+            return entry.actor;
+        }
+    }
+
+    return nullptr;
+}
+
+void CaptureActorPool::release(PuppetHackActor* actor) {
+    for (int i = 0; i < sCount; i++) {
+        Entry& entry = sEntries[i];
+
+        if (entry.actor == actor) {
+            if (!al::isDead(actor)) {
+                actor->makeActorDead();
+            }
+
+            entry.actor->setPuppetInfo(nullptr);
+            entry.isLeased = false;
+            return;
+        }
+    }
+}
+
+int CaptureActorPool::getLeasedCount() {
+    int count = 0;
+
+    for (int i = 0; i < sCount; i++) {
+        if (sEntries[i].isLeased) {
+            count++;
+        }
+    }
+
+    return count;
+}
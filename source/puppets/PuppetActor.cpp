@@ -13,10 +13,13 @@
 #include "al/util.hpp"
 #include "al/util/LiveActorUtil.h"
 #include "algorithms/CaptureTypes.h"
+#include "puppets/CaptureActorPool.hpp"
 #include "logger.hpp"
 #include "actors/PuppetActor.h"
 #include "math/seadQuat.h"
 #include "math/seadVector.h"
+#include "server/FrameProfiler.hpp"
+#include "server/PuppetQuery.hpp"
 #include "server/freeze/FreezeTagMode.hpp"
 #include "server/gamemode/GameModeManager.hpp"
 #include "server/gamemode/GameModeBase.hpp"
@@ -24,7 +27,7 @@
 #include "server/snh/SardineMode.hpp"
 // #include "server/manhunt/ManhuntMode.hpp"
 
-static const char *subActorNames[] = {
+static const char *subActorNames[PuppetModelParts::cSubActorCount] = {
     "顔", // Face
     "目", // Eye
     "頭", // Head
@@ -34,7 +37,6 @@ static const char *subActorNames[] = {
 
 PuppetActor::PuppetActor(const char *name) : al::LiveActor(name) {
     mPuppetCap = new PuppetCapActor(name);
-    mCaptures = new HackModelHolder();
     mModelHolder = new PlayerModelHolder(3); // Regular Model, 2D Model, 2D Mini Model
 }
 
@@ -46,10 +48,14 @@ void PuppetActor::init(al::ActorInitInfo const &initInfo) {
 
     const char *bodyName = "Mario";
     const char *capName = "Mario";
+    CostumeTypes::Type bodyType = CostumeTypes::Type::Mario;
+    CostumeTypes::Type capType = CostumeTypes::Type::Mario;
 
     if(mInfo) {
         bodyName = tryGetPuppetBodyName(mInfo);
         capName = tryGetPuppetCapName(mInfo);
+        bodyType = CostumeTypes::FindType(bodyName);
+        capType = CostumeTypes::FindType(capName);
 
         mNameTag = new NameTag(this, *al::getLayoutInitInfo(initInfo), 4900.0f, 5000.0f,
                                mInfo->puppetName);
@@ -58,7 +64,7 @@ void PuppetActor::init(al::ActorInitInfo const &initInfo) {
 
     al::LiveActor *normalModel = new al::LiveActor("Normal");
 
-    mCostumeInfo = initMarioModelPuppet(normalModel, initInfo, bodyName, capName, 0, nullptr);
+    mCostumeInfo = initMarioModelPuppet(normalModel, initInfo, bodyName, capName, bodyType, capType, 0, nullptr);
 
     normalModel->mActorActionKeeper->mPadAndCamCtrl->mRumbleCount = 0; // set rumble count to zero so that no rumble actions will run
 
@@ -129,19 +135,30 @@ void PuppetActor::calcAnim() {
 }
 
 void PuppetActor::control() { 
+    PROFILE_SCOPE(ProfileZone::PuppetControl);
+
     if(mInfo) {
 
         al::LiveActor* curModel = getCurrentModel();
 
+        // LOD Updating
+
+        PuppetLod prevLod = mLod;
+        mLod = calcLod(curModel);
+
+        // the model pose is always synced when moving up a tier, so a puppet coming close or on screen doesn't lag
+        bool isSyncPose = mLod < prevLod || isLodUpdateFrame();
+
         // Animation Updating
 
-        if(!al::isActionPlaying(curModel, mInfo->curSubAnimStr)) {
-            startAction(mInfo->curAnimStr);
-        }else if(al::isActionEnd(curModel)) {
-            startAction(mInfo->curAnimStr);
+        // a started sub animation holds off the main one until it ends, same as checking the sub action by name
+        bool isAnimPlaying = isAnimStarted(curModel, mInfo->curAnim) || isAnimStarted(curModel, mInfo->curSubAnim);
+
+        if(!isAnimPlaying || al::isActionEnd(curModel)) {
+            startAction(mInfo->curAnim, mInfo->curAnimStr);
         }
 
-        if(isNeedBlending()) {
+        if(mLod == PuppetLod::Full && isNeedBlending()) {
             for (size_t i = 0; i < 6; i++)
             {
                 setBlendWeight(i, mInfo->blendWeights[i]);
@@ -173,10 +190,12 @@ void PuppetActor::control() {
         if (!mIs2DModel && mInfo->is2D) {
             changeModel("Normal2D");
             mIs2DModel = true;
+            isSyncPose = true;
 
         } else if (mIs2DModel && !mInfo->is2D) {
             changeModel("Normal");
             mIs2DModel = false;
+            isSyncPose = true;
         }
 
         // Capture Updating
@@ -188,13 +207,27 @@ void PuppetActor::control() {
             setCapture(mInfo->curHack);
             mIsCaptureModel =  true;
             getCurrentModel()->makeActorAlive(); // make new model alive
+            isSyncPose = true;
 
         } else if (!mInfo->isCaptured && mIsCaptureModel) {
 
             getCurrentModel()->makeActorDead(); // make capture model dead
+            releaseCapture(); // hand the capture actor back to the pool
             mModelHolder->changeModel("Normal"); // set player model to normal
             mIsCaptureModel = false;
             getCurrentModel()->makeActorAlive(); // make player model alive
+            isSyncPose = true;
+
+        } else if (mInfo->isCaptured && mIsCaptureModel && !mCaptureActor) {
+
+            // every pooled actor of this capture was leased when the capture started, so the player model is standing
+            // in for it until another puppet releases one
+            al::LiveActor* playerModel = getCurrentModel();
+            if (setCapture(mInfo->curHack)) {
+                playerModel->makeActorDead();
+                getCurrentModel()->makeActorAlive();
+                isSyncPose = true;
+            }
 
         }
 
@@ -212,7 +245,7 @@ void PuppetActor::control() {
 
                 startAction(mInfo->curSubAnimStr);
 
-                al::LiveActor* headModel = al::getSubActor(curModel, "頭");
+                al::LiveActor* headModel = getModelParts().getHead();
                 if (headModel) { al::startVisAnimForAction(headModel, "CapOn"); }
             }
         }
@@ -236,7 +269,7 @@ void PuppetActor::control() {
                     break;
                 }
                 default:
-                    Logger::log("Name tag display failed due to unknown active game mode!\n");
+                    LOG_ERROR(Puppet, "Name tag display failed due to unknown active game mode!\n");
                     break;
             };
         }
@@ -247,7 +280,8 @@ void PuppetActor::control() {
 
         // Syncing
 
-        syncPose();
+        if (isSyncPose)
+            syncPose();
 
     }
 }
@@ -279,6 +313,13 @@ void PuppetActor::makeActorDead() {
         curModel->makeActorDead();
     }
 
+    // give up the capture actor while out of the stage, control leases a new one if still captured on return
+    if (mIsCaptureModel) {
+        releaseCapture();
+        mModelHolder->changeModel("Normal");
+        mIsCaptureModel = false;
+    }
+
     mPuppetCap->makeActorDead();
 
     if(mFreezeTagIceBlock)
@@ -321,12 +362,20 @@ bool PuppetActor::receiveMsg(const al::SensorMsg* msg, al::HitSensor* source,
 
 // this is more or less how nintendo does it with marios demo puppet
 void PuppetActor::startAction(const char *actName) {
+    if(!actName) return;
+
+    startAction(PlayerAnims::FindType(actName), actName);
+}
+
+void PuppetActor::startAction(PlayerAnims::Type type, const char *actName) {
 
     al::LiveActor* curModel = getCurrentModel();
 
     if(!actName) return;
 
-    if(al::tryStartActionIfNotPlaying(curModel, actName)) {
+    bool isStarted = al::tryStartActionIfNotPlaying(curModel, actName);
+
+    if(isStarted) {
         const char *curActName = al::getActionName(curModel);
         if(curActName) {
             if(al::isSklAnimExist(curModel, curActName)) {
@@ -335,10 +384,21 @@ void PuppetActor::startAction(const char *actName) {
         }
     }
 
-    for (size_t i = 0; i < 5; i++)
+    // only remember the anim if the model actually plays it, otherwise isNeedBlending falls back to the action name
+    if (isStarted || al::isActionPlaying(curModel, actName)) {
+        mAnimModel = curModel;
+        mStartedAnim = type;
+    } else {
+        mAnimModel = nullptr;
+        mStartedAnim = PlayerAnims::Type::Unknown;
+    }
+
+    const PuppetModelParts& parts = getModelParts();
+    const char *curActName = al::getActionName(curModel);
+
+    for (size_t i = 0; i < PuppetModelParts::cSubActorCount; i++)
     {
-        al::LiveActor* subActor = al::getSubActor(curModel, subActorNames[i]);
-        const char *curActName = al::getActionName(curModel);
+        al::LiveActor* subActor = parts.subActors[i];
         if(subActor && curActName) {
             if (al::tryStartActionIfNotPlaying(subActor, curActName)) {
                 if(al::isSklAnimExist(curModel, curActName)) {
@@ -348,60 +408,78 @@ void PuppetActor::startAction(const char *actName) {
         }
     }
 
-    al::LiveActor* faceActor = al::tryGetSubActor(curModel, "顔");
+    al::LiveActor* faceActor = parts.getFace();
 
     if (faceActor) {
-        al::StringTmp<0x80> faceAnim("%sFullFace", actName);
-        if (al::tryStartActionIfNotPlaying(faceActor, faceAnim.cstr())) {
-            if(al::isSklAnimExist(faceActor, faceAnim.cstr())) {
+        if (type != mFaceAnim || type == PlayerAnims::Type::Unknown) {
+            mFaceAnimName.format("%sFullFace", actName);
+            mFaceAnim = type;
+        }
+
+        if (al::tryStartActionIfNotPlaying(faceActor, mFaceAnimName.cstr())) {
+            if(al::isSklAnimExist(faceActor, mFaceAnimName.cstr())) {
                 al::clearSklAnimInterpole(faceActor);
             }
         }
     }
 }
 
+bool PuppetActor::isAnimStarted(const al::LiveActor* model, PlayerAnims::Type type) const {
+    return type != PlayerAnims::Type::Unknown && mAnimModel == model && mStartedAnim == type;
+}
+
 void PuppetActor::hairControl() {
 
-    al::LiveActor *curModel = getCurrentModel();
+    const PuppetModelParts& parts = getModelParts();
 
     if (mCostumeInfo->isNeedSyncBodyHair())
     {
-        PlayerFunction::syncBodyHairVisibility(al::getSubActor(curModel, "髪"), al::getSubActor(curModel, "頭"));
+        PlayerFunction::syncBodyHairVisibility(parts.hair, parts.getHead());
     }
     if (mCostumeInfo->isSyncFaceBeard())
     {
-        PlayerFunction::syncMarioFaceBeardVisibility(al::getSubActor(curModel, "顔"), al::getSubActor(curModel, "頭"));
+        PlayerFunction::syncMarioFaceBeardVisibility(parts.getFace(), parts.getHead());
     }
     if (mCostumeInfo->isSyncStrap())
     {
-        PlayerFunction::syncMarioHeadStrapVisibility(al::getSubActor(curModel, "頭"));
+        PlayerFunction::syncMarioHeadStrapVisibility(parts.getHead());
     }
     if (PlayerFunction::isNeedHairControl(mCostumeInfo->mBodyInfo, mCostumeInfo->mHeadInfo->costumeName))
     {
-        PlayerFunction::hideHairVisibility(al::getSubActor(curModel, "頭"));
+        PlayerFunction::hideHairVisibility(parts.getHead());
     }
 }
 
-bool PuppetActor::isNeedBlending() {
-    const char *curActName = al::getActionName(getCurrentModel());
-    if(curActName) {
-        return al::isEqualSubString(curActName, "Move") || al::isEqualSubString(curActName, "Sand") || al::isEqualSubString(curActName, "MotorcycleRide");
-    }else {
-        return false;
+const PuppetModelParts& PuppetActor::getModelParts() {
+    al::LiveActor* curModel = getCurrentModel();
+
+    if (mModelParts.model != curModel) {
+        mModelParts.model = curModel;
+
+        for (int i = 0; i < PuppetModelParts::cSubActorCount; i++) {
+            mModelParts.subActors[i] = al::tryGetSubActor(curModel, subActorNames[i]);
+        }
+
+        mModelParts.hair = al::tryGetSubActor(curModel, "髪");
     }
-}
 
-bool PuppetActor::isInCaptureList(const char *hackName) {
-    return mCaptures->getCapture(hackName) != nullptr;
+    return mModelParts;
 }
 
-bool PuppetActor::addCapture(PuppetHackActor* capture, const char* hackType) {
+bool PuppetActor::isNeedBlending() {
+    al::LiveActor* curModel = getCurrentModel();
+
+    // the model is playing the animation this puppet started, so its flags can be read straight from the table
+    if (isAnimStarted(curModel, mStartedAnim)) {
+        return PlayerAnims::IsNeedBlending(mStartedAnim);
+    }
 
-    if (mCaptures->addCapture(capture, hackType)) {
-        return true;
+    const char *curActName = al::getActionName(curModel);
+    if(curActName) {
+        return al::isEqualSubString(curActName, "Move") || al::isEqualSubString(curActName, "Sand") || al::isEqualSubString(curActName, "MotorcycleRide");
+    }else {
+        return false;
     }
-    
-    return false;
 }
 
 void PuppetActor::changeModel(const char* newModel) {
@@ -411,33 +489,20 @@ void PuppetActor::changeModel(const char* newModel) {
 }
 
 al::LiveActor* PuppetActor::getCurrentModel() {
-    if (mIsCaptureModel) {
-        al::LiveActor* curCapture = mCaptures->getCurrentActor();
-        if (curCapture) {
-            return curCapture;
-        }
+    if (mIsCaptureModel && mCaptureActor) {
+        return mCaptureActor;
     }
     return mModelHolder->currentModel->mLiveActor;
 }
 
-void PuppetActor::debugTeleportCaptures(const sead::Vector3f& pos) {
-    for (int i = 0; i < mCaptures->getEntryCount(); i++) {
-        al::LiveActor* capture = mCaptures->getCapture(i);
-        if (capture) {
-            al::setTrans(capture, al::getTrans(getCurrentModel()));
-        }
-    }
-}
+bool PuppetActor::setCapture(const char* captureName) {
+    releaseCapture();
 
-void PuppetActor::debugTeleportCapture(const sead::Vector3f& pos, int index) {
-    al::LiveActor* capture = mCaptures->getCapture(index);
-    if (capture) {
-        al::setTrans(capture, al::getTrans(getCurrentModel()));
+    if (captureName) {
+        mCaptureActor = CaptureActorPool::lease(captureName, mInfo);
     }
-}
 
-bool PuppetActor::setCapture(const char* captureName) {
-    if (captureName && mCaptures->setCurrent(captureName)) {
+    if (mCaptureActor) {
         mCurCapture = CaptureTypes::FindType(captureName);
         return true;
     } else {
@@ -446,6 +511,17 @@ bool PuppetActor::setCapture(const char* captureName) {
     }
 }
 
+void PuppetActor::releaseCapture() {
+    if (mCaptureActor) {
+        // other puppets will start their own actions on it
+        if (mAnimModel == mCaptureActor)
+            mAnimModel = nullptr;
+
+        CaptureActorPool::release(mCaptureActor);
+        mCaptureActor = nullptr;
+    }
+}
+
 void PuppetActor::syncPose() {
 
     al::LiveActor* curModel = getCurrentModel();
@@ -456,6 +532,51 @@ void PuppetActor::syncPose() {
 
 }
 
+PuppetLod PuppetActor::calcLod(al::LiveActor* curModel) const {
+    // camera distances for the LOD tiers, a tier is only left once the puppet is cLodHysteresis closer than the
+    // distance it entered at, so puppets on a border don't flip between tiers every frame
+    constexpr float cLodReducedDist = 3000.f;
+    constexpr float cLodMinimalDist = 8000.f;
+    constexpr float cLodHysteresis = 500.f;
+
+    // the debug puppet isn't in PuppetQuery
+    if (mIsDebug || mPuppetIndex < 0 || !PuppetQuery::isValid())
+        return PuppetLod::Full;
+
+    if (al::isClipped(curModel))
+        return PuppetLod::Minimal;
+
+    float reducedDist = mLod >= PuppetLod::Reduced ? cLodReducedDist - cLodHysteresis : cLodReducedDist;
+    float minimalDist = mLod == PuppetLod::Minimal ? cLodMinimalDist - cLodHysteresis : cLodMinimalDist;
+    float distSq = PuppetQuery::get(this).cameraDistSq;
+
+    if (distSq >= minimalDist * minimalDist)
+        return PuppetLod::Minimal;
+
+    if (distSq >= reducedDist * reducedDist)
+        return PuppetLod::Reduced;
+
+    return PuppetLod::Full;
+}
+
+bool PuppetActor::isLodUpdateFrame() const {
+    int interval;
+
+    switch (mLod) {
+    case PuppetLod::Reduced:
+        interval = 2;
+        break;
+    case PuppetLod::Minimal:
+        interval = 4;
+        break;
+    default:
+        return true;
+    }
+
+    // offset by the puppet index so throttled puppets don't all update on the same frame
+    return (PuppetQuery::getFrameCount() + mPuppetIndex) % interval == 0;
+}
+
 void PuppetActor::emitJoinEffect() {
 
     al::tryDeleteEffect(this, "Disappear"); // remove previous effect (if played previously)
@@ -479,6 +600,7 @@ const char *executorName = "ＮＰＣ";
 PlayerCostumeInfo* initMarioModelPuppet(al::LiveActor* player,
                                                         const al::ActorInitInfo& initInfo,
                                                         const char* bodyName, const char* capName,
+                                                        CostumeTypes::Type bodyType, CostumeTypes::Type capType,
                                                         int subActorNum,
                                                         al::AudioKeeper* audioKeeper) {
 
@@ -574,10 +696,16 @@ PlayerCostumeInfo* initMarioModelPuppet(al::LiveActor* player,
 
     // Logger::log("Getting Cap Model/Head Model Name.\n");
     
+    // costumes in CostumeTypes use precomputed model info, custom costumes fall back to comparing names
+
+    const CostumeTypes::ModelInfo* bodyModelInfo = CostumeTypes::FindModelInfo(bodyType);
+    const CostumeTypes::ModelInfo* capModelInfo = CostumeTypes::FindModelInfo(capType);
+
     const char *capModelName;
 
     if (bodyInfo->mIsUseHeadSuffix) {
-        if (al::isEqualString(bodyInfo->costumeName, capName)) {
+        bool isSameCostume = bodyModelInfo && capModelInfo ? bodyType == capType : al::isEqualString(bodyInfo->costumeName, capName);
+        if (isSameCostume) {
             capModelName = "";
         } else {
             capModelName = capName;
@@ -588,16 +716,16 @@ PlayerCostumeInfo* initMarioModelPuppet(al::LiveActor* player,
 
     const char *headType;
 
-    if (!al::isEqualSubString(capName, "Mario64")) {
-        if (bodyInfo->mIsUseShortHead && al::isEqualString(capName, "MarioPeach")) {
+    bool isMario64Cap = capModelInfo ? capModelInfo->isMario64Cap : al::isEqualSubString(capName, "Mario64");
+
+    if (!isMario64Cap) {
+        if (bodyInfo->mIsUseShortHead && capModelInfo && capModelInfo->isShortHeadCap) {
             headType = "Short";
         } else {
             headType = "";
         }
-    } else if (al::isEqualString(bodyInfo->costumeName, "Mario64")) {
-        headType = "";
-    } else if (al::isEqualString(bodyInfo->costumeName, "Mario64Metal")) {
-        headType = "Metal";
+    } else if (bodyModelInfo) {
+        headType = bodyModelInfo->head64Type;
     } else {
         headType = "Other";
     }
@@ -614,7 +742,7 @@ PlayerCostumeInfo* initMarioModelPuppet(al::LiveActor* player,
 
     if (costumeInfo->isNeedBodyHair()) {
 
-        Logger::log("Creating Body Hair Parts Model.\n");
+        LOG_DEBUG(Puppet, "Creating Body Hair Parts Model.\n");
 
         al::PartsModel* partsModel = new al::PartsModel("髪");
 
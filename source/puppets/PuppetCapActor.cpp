@@ -51,7 +51,7 @@ void PuppetCapActor::movement() {
 }
 
 void PuppetCapActor::control() {
-    if(mInfo->capAnim) {
+    if(mInfo->capAnim != mCurAnim) {
         startAction(mInfo->capAnim);
     }
 
@@ -113,13 +113,24 @@ bool PuppetCapActor::receiveMsg(const al::SensorMsg* msg, al::HitSensor* sender,
     return false;
 }
 
-void PuppetCapActor::startAction(const char *actName) {
+void PuppetCapActor::startAction(CapAnims::Type anim) {
+
+    mCurAnim = anim;
+
+    const s16 animIdx = (s16)anim;
+
+    // unknown anims keep whatever action is currently playing
+    if (animIdx < 0 || animIdx >= CapAnims::ToValue(CapAnims::Type::End) || mIsAnimMissing[animIdx])
+        return;
+
+    const char *actName = CapAnims::FindStr(anim);
+
     if(al::tryStartActionIfNotPlaying(this, actName)) {
-        const char *curActName = al::getActionName(this);
-        if(curActName) {
-            if(al::isSklAnimExist(this, curActName)) {
-                al::clearSklAnimInterpole(this);
-            }
+        if(al::isSklAnimExist(this, actName)) {
+            al::clearSklAnimInterpole(this);
         }
+    } else if (!al::isActionPlaying(this, actName)) {
+        LOG_WARN(Puppet, "Cap Model has no action named %s.\n", actName);
+        mIsAnimMissing[animIdx] = true;
     }
 }
\ No newline at end of file
@@ -7,10 +7,11 @@
 #include "heap/seadHeap.h"
 #include "heap/seadHeapMgr.h"
 #include "logger.hpp"
+#include "server/FrameProfiler.hpp"
 
 PuppetHolder::PuppetHolder(int size) {
     if(!mPuppetArr.tryAllocBuffer(size, nullptr)) {
-        Logger::log("Buffer Alloc Failed on Puppet Holder!\n");
+        LOG_ERROR(Puppet, "Buffer Alloc Failed on Puppet Holder!\n");
     }
 }
 /**
@@ -51,6 +52,7 @@ bool PuppetHolder::resizeHolder(int size) {
 
 bool PuppetHolder::tryRegisterPuppet(PuppetActor *puppet) {
     if(!mPuppetArr.isFull()) {
+        puppet->setPuppetIndex(mPuppetArr.size());
         mPuppetArr.pushBack(puppet);
         return true;
     }else {
@@ -71,6 +73,7 @@ PuppetActor *PuppetHolder::getDebugPuppet() {
 }
 
 void PuppetHolder::update() {
+    PROFILE_SCOPE(ProfileZone::PuppetHolderUpdate);
 
     for (size_t i = 0; i < mPuppetArr.size(); i++)
     {
@@ -1,6 +1,7 @@
 #include "server/Client.hpp"
 #include "logger.hpp"
 #include "main.hpp"
+#include "puppets/CaptureActorPool.hpp"
 
 al::LiveActor *createPuppetActorFromFactory(al::ActorInitInfo const &rootInitInfo, al::PlacementInfo const &rootPlacementInfo, bool isDebug) {
     al::ActorInitInfo actorInitInfo = al::ActorInitInfo();
@@ -15,7 +16,7 @@ al::LiveActor *createPuppetActorFromFactory(al::ActorInitInfo const &rootInitInf
             if(Client::tryAddPuppet(newActor)) {
                 PuppetInfo *curInfo = Client::getLatestInfo();
                 if(!curInfo) {
-                    Logger::log("Puppet Info is Null!\n");
+                    LOG_ERROR(Puppet, "Puppet Info is Null!\n");
                 }else {
 
                     newActor->initOnline(curInfo); // set puppet info first before calling init so we can get costume info from the info
@@ -25,7 +26,7 @@ al::LiveActor *createPuppetActorFromFactory(al::ActorInitInfo const &rootInitInf
             }
         } else {
 
-            Logger::log("Creating Test Puppet.\n");
+            LOG_INFO(Puppet, "Creating Test Puppet.\n");
 
             newActor->initOnline(Client::getDebugPuppetInfo()); 
 
@@ -36,7 +37,7 @@ al::LiveActor *createPuppetActorFromFactory(al::ActorInitInfo const &rootInitInf
             newActor->makeActorAlive();
 
             if (Client::tryAddDebugPuppet(newActor)) {
-                Logger::log("Debug Puppet Created!\n");
+                LOG_INFO(Puppet, "Debug Puppet Created!\n");
             }
 
         }
@@ -52,6 +53,8 @@ al::LiveActor *createPuppetActorFromFactory(al::ActorInitInfo const &rootInitInf
 void initPuppetActors(al::Scene *scene, al::ActorInitInfo const &rootInfo, char const *listName) {
     al::StageInfo *stageInfo = al::getStageInfoMap(scene, 0);
 
+    CaptureActorPool::reset(); // capture actors are created again by initObjHook for this stage
+
     int placementCount = 0;
     al::PlacementInfo rootPlacement = al::PlacementInfo();
     al::tryGetPlacementInfoAndCount(&rootPlacement, &placementCount, stageInfo, "PlayerList");
@@ -60,6 +63,8 @@ void initPuppetActors(al::Scene *scene, al::ActorInitInfo const &rootInfo, char
         al::PlacementInfo playerPlacement = al::PlacementInfo();
         al::getPlacementInfoByIndex(&playerPlacement, rootPlacement, 0);
 
+        Client::syncPuppetInfosForInit(); // PuppetActor::init reads the costume from the info
+
         for (size_t i = 0; i < Client::getMaxPlayerCount(); i++)
         {
             createPuppetActorFromFactory(rootInfo, playerPlacement, false);
@@ -6,9 +6,21 @@
 #include "logger.hpp"
 #include "packets/Packet.h"
 #include "server/hns/HideAndSeekMode.hpp"
+#include "server/DeltaTime.hpp"
+#include "server/FrameProfiler.hpp"
+#include "server/NetStats.hpp"
+#include "server/PuppetQuery.hpp"
+#include "server/ThreadConfig.hpp"
 
 SEAD_SINGLETON_DISPOSER_IMPL(Client)
 
+// pads every PuppetInfo to whole cache lines so the hot fields of each info start on a line boundary
+struct alignas(0x40) PuppetInfoSlot {
+    PuppetInfo info;
+};
+
+static_assert(sizeof(PuppetInfoSlot) % 0x40 == 0, "PuppetInfoSlot must fill whole cache lines");
+
 typedef void (Client::*ClientThreadFunc)(void);
 
 /**
@@ -23,7 +35,7 @@ Client::Client() {
     sead::ScopedCurrentHeapSetter heapSetter(
         mHeap);  // every new call after this will use ClientHeap instead of SequenceHeap
 
-    mReadThread = new al::AsyncFunctorThread("ClientReadThread", al::FunctorV0M<Client*, ClientThreadFunc>(this, &Client::readFunc), 0, 0x1000, {0});
+    mReadThread = ThreadConfig::createThread(NetThread::ClientRead, al::FunctorV0M<Client*, ClientThreadFunc>(this, &Client::readFunc));
 
     mKeyboard = new Keyboard(nn::swkbd::GetRequiredStringBufferSize());
 
@@ -31,9 +43,11 @@ Client::Client() {
     
     mPuppetHolder = new PuppetHolder(maxPuppets);
 
+    PuppetInfoSlot* puppetInfoSlots = new (mHeap, 0x40) PuppetInfoSlot[MAXPUPINDEX];
+
     for (size_t i = 0; i < MAXPUPINDEX; i++)
     {
-        mPuppetInfoArr[i] = new PuppetInfo();
+        mPuppetInfoArr[i] = &puppetInfoSlots[i].info;
 
         sprintf(mPuppetInfoArr[i]->puppetName, "Puppet%zu", i);
     }
@@ -42,11 +56,7 @@ Client::Client() {
 
     mConnectCount = 0;
 
-    curCollectedShines.fill(-1);
-
-    collectedShineCount = 0;
-
-    mShineArray.allocBuffer(100, nullptr); // max of 100 shine actors in buffer
+    curCollectedShines.makeAllZero();
 
     nn::account::GetLastOpenedUser(&mUserID);
 
@@ -58,9 +68,9 @@ Client::Client() {
     
     mUserID.print();
 
-    Logger::log("Player Name: %s\n", playerName.name);
+    LOG_INFO(Net, "Player Name: %s\n", playerName.name);
 
-    Logger::log("%s Build Number: %s\n", playerName.name, TOSTRING(BUILDVERSTR));
+    LOG_INFO(Net, "%s Build Number: %s\n", playerName.name, TOSTRING(BUILDVERSTR));
 
 }
 
@@ -85,7 +95,7 @@ void Client::init(al::LayoutInitInfo const &initInfo, GameDataHolderAccessor hol
 
     startThread();
 
-    Logger::log("Heap Free Size: %f/%f\n", mHeap->getFreeSize() * 0.001f, mHeap->getSize() * 0.001f);
+    LOG_DEBUG(Net, "Heap Free Size: %f/%f\n", mHeap->getFreeSize() * 0.001f, mHeap->getSize() * 0.001f);
 }
 /**
  * @brief starts client read thread
@@ -96,10 +106,10 @@ void Client::init(al::LayoutInitInfo const &initInfo, GameDataHolderAccessor hol
 bool Client::startThread() {
     if(mReadThread->isDone() ) {
         mReadThread->start();
-        Logger::log("Read Thread Sucessfully Started.\n");
+        LOG_INFO(Net, "Read Thread Sucessfully Started.\n");
         return true;
     }else {
-        Logger::log("Read Thread has already started! Or other unknown reason.\n");
+        LOG_WARN(Net, "Read Thread has already started! Or other unknown reason.\n");
         return false;
     }
 }
@@ -110,13 +120,13 @@ bool Client::startThread() {
 void Client::restartConnection() {
 
     if (!sInstance) {
-        Logger::log("Static Instance is null!\n");
+        LOG_ERROR(Net, "Static Instance is null!\n");
         return;
     }
 
     sead::ScopedCurrentHeapSetter setter(sInstance->mHeap);
 
-    Logger::log("Sending Disconnect.\n");
+    LOG_INFO(Net, "Sending Disconnect.\n");
 
     PlayerDC *playerDC = new PlayerDC();
 
@@ -125,7 +135,7 @@ void Client::restartConnection() {
     sInstance->mSocket->queuePacket(playerDC);
 
     if (sInstance->mSocket->closeSocket()) {
-        Logger::log("Sucessfully Closed Socket.\n");
+        LOG_INFO(Net, "Sucessfully Closed Socket.\n");
     }
 
     sInstance->mConnectCount = 0;
@@ -134,10 +144,10 @@ void Client::restartConnection() {
 
     if(sInstance->mSocket->getLogState() == SOCKET_LOG_CONNECTED) {
 
-        Logger::log("Reconnect Sucessful!\n");
+        LOG_INFO(Net, "Reconnect Sucessful!\n");
 
     } else {
-        Logger::log("Reconnect Unsuccessful.\n");
+        LOG_WARN(Net, "Reconnect Unsuccessful.\n");
     }
 }
 /**
@@ -176,7 +186,7 @@ bool Client::startConnection() {
 
     if (mIsConnectionActive) {
 
-        Logger::log("Sucessful Connection. Waiting to recieve init packet.\n");
+        LOG_INFO(Net, "Sucessful Connection. Waiting to recieve init packet.\n");
 
         bool waitingForInitPacket = true;
         // wait for client init packet
@@ -190,7 +200,7 @@ bool Client::startConnection() {
                 if (curPacket->mType == PacketType::CLIENTINIT) {
                     InitPacket* initPacket = (InitPacket*)curPacket;
 
-                    Logger::log("Server Max Player Size: %d\n", initPacket->maxPlayers);
+                    LOG_INFO(Net, "Server Max Player Size: %d\n", initPacket->maxPlayers);
 
                     maxPuppets = initPacket->maxPlayers - 1;
 
@@ -200,7 +210,7 @@ bool Client::startConnection() {
                 free(curPacket);
 
             } else {
-                Logger::log("Recieve failed! Stopping Connection.\n");
+                LOG_ERROR(Net, "Recieve failed! Stopping Connection.\n");
                 mIsConnectionActive = false;
                 waitingForInitPacket = false;
             }
@@ -217,7 +227,7 @@ bool Client::startConnection() {
 bool Client::openKeyboardIP() {
 
     if (!sInstance) {
-        Logger::log("Static Instance is null!\n");
+        LOG_ERROR(Net, "Static Instance is null!\n");
         return false;
     }
 
@@ -256,7 +266,7 @@ bool Client::openKeyboardIP() {
 bool Client::openKeyboardPort() {
 
     if (!sInstance) {
-        Logger::log("Static Instance is null!\n");
+        LOG_ERROR(Net, "Static Instance is null!\n");
         return false;
     }
 
@@ -308,7 +318,7 @@ void Client::readFunc() {
 
     if (!startConnection()) {
 
-        Logger::log("Failed to Connect to Server.\n");
+        LOG_ERROR(Net, "Failed to Connect to Server.\n");
 
         nn::os::SleepThread(nn::TimeSpan::FromNanoSeconds(250000000)); // sleep active thread for 0.25 seconds
 
@@ -323,78 +333,183 @@ void Client::readFunc() {
 
     while(mIsConnectionActive) {
 
+        ThreadConfig::updateCurrentThread(NetThread::ClientRead);
+
         Packet *curPacket = mSocket->tryGetPacket();  // will block until a packet has been recieved, or socket disconnected
 
         if (curPacket) {
 
-            switch (curPacket->mType)
-            {
-            case PacketType::PLAYERINF:
-                updatePlayerInfo((PlayerInf*)curPacket);
-                break;
-            case PacketType::GAMEINF:
-                updateGameInfo((GameInf*)curPacket);
-                break;
-            case PacketType::HACKCAPINF:
-                updateHackCapInfo((HackCapInf *)curPacket);
-                break;
-            case PacketType::CAPTUREINF:                    
-                updateCaptureInfo((CaptureInf*)curPacket);
-                break;
-            case PacketType::PLAYERCON:
-                updatePlayerConnect((PlayerConnect*)curPacket);
-
-                // Send relevant info packets when another client is connected
-
-                // Assume game packets are empty from first connection
-                 if (lastGameInfPacket.mUserID != mUserID)
-                     lastGameInfPacket.mUserID = mUserID;
-                 mSocket->send(&lastGameInfPacket);
+            // replies go out from here so the game thread never blocks on the socket
+            if (curPacket->mType == PacketType::PLAYERCON) {
+                sendPlayerConnectReplies();
+            }
 
-                 // No need to send player/costume packets if they're empty
-                 if (lastPlayerInfPacket.mUserID == mUserID)
-                     mSocket->send(&lastPlayerInfPacket);
-                 if (lastCostumeInfPacket.mUserID == mUserID)
-                     mSocket->send(&lastCostumeInfPacket);
+            sead::ScopedLock<sead::Mutex> lock(&mApplyModeMutex);
 
-                break;
-            case PacketType::COSTUMEINF:
-                updateCostumeInfo((CostumeInf*)curPacket);
-                break;
-            case PacketType::SHINECOLL:
-                updateShineInfo((ShineCollect*)curPacket);
-                break;
-            case PacketType::PLAYERDC:
-                Logger::log("Received Player Disconnect!\n");
-                curPacket->mUserID.print();
-                disconnectPlayer((PlayerDC*)curPacket);
-                break;
-            case PacketType::GAMEMODEINF:
-                GameModeManager::processModePacket(curPacket);
-                break;
-            case PacketType::CHANGESTAGE:
-                sendToStage((ChangeStagePacket*)curPacket);
-                break;
-            case PacketType::CLIENTINIT: {
-                InitPacket* initPacket = (InitPacket*)curPacket;
-                Logger::log("Server Max Player Size: %d\n", initPacket->maxPlayers);
-                maxPuppets = initPacket->maxPlayers - 1;
-                break;
-            }
-            default:
-                Logger::log("Discarding Unknown Packet Type.\n");
-                break;
+            // in batch mode the packet is only ever applied by the game thread at the start of the next frame
+            if (!mIsBatchApply.load(std::memory_order_relaxed)) {
+                applyPacket(curPacket);
+            } else {
+                stagePacket(curPacket);
             }
 
-            free(curPacket);
-
         }else { // if false, socket has errored or disconnected, so close the socket and end this thread.
-            Logger::log("Client Socket Encountered an Error! Errno: 0x%x\n", mSocket->socket_errno);
+            LOG_ERROR(Net, "Client Socket Encountered an Error! Errno: 0x%x\n", mSocket->socket_errno);
         }
 
     }
 
-    Logger::log("Client Read Thread ending.\n");
+    LOG_INFO(Net, "Client Read Thread ending.\n");
+}
+
+/**
+ * @brief applies a received packet to the client state and frees it
+ * 
+ * @param curPacket packet obtained from the socket recv queue
+ */
+void Client::applyPacket(Packet *curPacket) {
+    switch (curPacket->mType)
+    {
+    case PacketType::PLAYERINF:
+        updatePlayerInfo((PlayerInf*)curPacket);
+        break;
+    case PacketType::GAMEINF:
+        updateGameInfo((GameInf*)curPacket);
+        break;
+    case PacketType::HACKCAPINF:
+        updateHackCapInfo((HackCapInf *)curPacket);
+        break;
+    case PacketType::CAPTUREINF:                    
+        updateCaptureInfo((CaptureInf*)curPacket);
+        break;
+    case PacketType::PLAYERCON:
+        updatePlayerConnect((PlayerConnect*)curPacket);
+        break;
+    case PacketType::COSTUMEINF:
+        updateCostumeInfo((CostumeInf*)curPacket);
+        break;
+    case PacketType::SHINECOLL:
+        updateShineInfo((ShineCollect*)curPacket);
+        break;
+    case PacketType::SHINESYNC:
+        updateShineSync((ShineSync*)curPacket);
+        break;
+    case PacketType::PLAYERDC:
+        LOG_INFO(Net, "Received Player Disconnect!\n");
+        curPacket->mUserID.print();
+        disconnectPlayer((PlayerDC*)curPacket);
+        break;
+    case PacketType::GAMEMODEINF:
+        GameModeManager::processModePacket(curPacket);
+        break;
+    case PacketType::CHANGESTAGE:
+        sendToStage((ChangeStagePacket*)curPacket);
+        break;
+    case PacketType::CLIENTINIT: {
+        InitPacket* initPacket = (InitPacket*)curPacket;
+        LOG_INFO(Net, "Server Max Player Size: %d\n", initPacket->maxPlayers);
+        maxPuppets = initPacket->maxPlayers - 1;
+        break;
+    }
+    default:
+        LOG_WARN(Net, "Discarding Unknown Packet Type.\n");
+        break;
+    }
+
+    free(curPacket);
+}
+
+/**
+ * @brief sends our last info packets to a newly connected client, called on the read thread when PLAYERCON arrives
+ * 
+ */
+void Client::sendPlayerConnectReplies() {
+    // Send relevant info packets when another client is connected
+
+    // Assume game packets are empty from first connection
+    if (lastGameInfPacket.mUserID != mUserID)
+        lastGameInfPacket.mUserID = mUserID;
+    mSocket->send(&lastGameInfPacket);
+
+    // No need to send player/costume packets if they're empty
+    if (lastPlayerInfPacket.mUserID == mUserID)
+        mSocket->send(&lastPlayerInfPacket);
+    if (lastCostumeInfPacket.mUserID == mUserID)
+        mSocket->send(&lastCostumeInfPacket);
+}
+
+/**
+ * @brief stages a packet for the next applyPacketBatch, called by the read thread with mApplyModeMutex held. the
+ * queue grows while the game thread isn't applying (scene loads), so state packets are never dropped here
+ * 
+ * @param curPacket packet obtained from the socket recv queue
+ */
+void Client::stagePacket(Packet *curPacket) {
+    if (curPacket->mType == PacketType::PLAYERDC) {
+        mApplyQueue.forgetPlayer(curPacket->mUserID);
+    }
+
+    if (!mApplyQueue.push(curPacket)) {
+        // out of memory, applying it now is better than losing a connect or disconnect
+        LOG_ERROR(Net, "Apply queue couldn't grow, applying %s on the read thread.\n", packetNames[curPacket->mType]);
+        applyPacket(curPacket);
+        return;
+    }
+
+    NetStats::recordQueueCount(NetQueue::Apply, mApplyQueue.getCount());
+}
+
+/**
+ * @brief applies every packet staged by the read thread since the last frame, used when batch apply is enabled
+ * 
+ */
+void Client::applyPacketBatch() {
+
+    // nothing is staged in immediate mode, toggleBatchApply empties the queue before leaving batch mode
+    if (!mIsBatchApply.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    sead::ScopedLock<sead::Mutex> lock(&mApplyModeMutex);
+
+    applyStagedPackets();
+}
+
+/**
+ * @brief applies and frees every staged packet in the order they were received, mApplyModeMutex has to be held
+ * 
+ */
+void Client::applyStagedPackets() {
+
+    sead::TickTime startTime;
+
+    int count = mApplyQueue.getCount();
+
+    for (int i = 0; i < count; i++) {
+        applyPacket(mApplyQueue.get(i));
+    }
+
+    mApplyQueue.clear();
+
+    mLastBatchCount = count;
+    mLastBatchTime = startTime.diffToNow().toMicroSeconds();
+}
+
+/**
+ * @brief switches between batched and immediate packet apply. packets staged so far are applied first, so none are
+ * left in the queue and they stay in order with the ones the read thread applies after the switch
+ * 
+ */
+void Client::toggleBatchApply() {
+    if (!sInstance) {
+        return;
+    }
+
+    sead::ScopedLock<sead::Mutex> lock(&sInstance->mApplyModeMutex);
+
+    sInstance->applyStagedPackets();
+
+    sInstance->mIsBatchApply.store(!sInstance->mIsBatchApply.load(std::memory_order_relaxed), std::memory_order_relaxed);
 }
 
 /**
@@ -405,12 +520,12 @@ void Client::readFunc() {
 void Client::sendPlayerInfPacket(const PlayerActorBase *playerBase, bool isYukimaru) {
 
     if (!sInstance) {
-        Logger::log("Static Instance is Null!\n");
+        LOG_ERROR(Net, "Static Instance is Null!\n");
         return;
     }
     
     if(!playerBase) {
-        Logger::log("Error: Null Player Reference\n");
+        LOG_ERROR(Net, "Null Player Reference\n");
         return;
     }
 
@@ -487,7 +602,7 @@ void Client::sendPlayerInfPacket(const PlayerActorBase *playerBase, bool isYukim
 void Client::sendHackCapInfPacket(const HackCap* hackCap) {
 
     if (!sInstance) {
-        Logger::log("Static Instance is Null!\n");
+        LOG_ERROR(Net, "Static Instance is Null!\n");
         return;
     }
 
@@ -508,7 +623,13 @@ void Client::sendHackCapInfPacket(const HackCap* hackCap) {
         packet->capQuat.z = hackCap->mJointKeeper->mJointRot.z;
         packet->capQuat.w = hackCap->mJointKeeper->mSkew;
 
-        strcpy(packet->capAnim, al::getActionName(hackCap));
+        const char* capActName = al::getActionName(hackCap);
+
+        packet->capAnim = capActName ? CapAnims::FindType(capActName) : CapAnims::Type::Unknown;
+
+        if (packet->capAnim == CapAnims::Type::Unknown && capActName && sInstance->tryAddWarnedCapAnim(capActName)) {
+            LOG_WARN(Net, "%s: cap action %s is missing from CapAnims\n", __func__, capActName);
+        }
 
         sInstance->mSocket->queuePacket(packet);
 
@@ -534,7 +655,7 @@ void Client::sendHackCapInfPacket(const HackCap* hackCap) {
 void Client::sendGameInfPacket(const PlayerActorHakoniwa* player, GameDataHolderAccessor holder) {
 
     if (!sInstance) {
-        Logger::log("Static Instance is Null!\n");
+        LOG_ERROR(Net, "Static Instance is Null!\n");
         return;
     }
 
@@ -569,7 +690,7 @@ void Client::sendGameInfPacket(const PlayerActorHakoniwa* player, GameDataHolder
 void Client::sendGameInfPacket(GameDataHolderAccessor holder) {
 
     if (!sInstance) {
-        Logger::log("Static Instance is Null!\n");
+        LOG_ERROR(Net, "Static Instance is Null!\n");
         return;
     }
 
@@ -596,7 +717,7 @@ void Client::sendGameInfPacket(GameDataHolderAccessor holder) {
 void Client::sendGamemodePacket() {
 
     if (!sInstance) {
-        Logger::log("Static Instance is Null!\n");
+        LOG_ERROR(Net, "Static Instance is Null!\n");
         return;
     }
 
@@ -619,7 +740,7 @@ void Client::sendGamemodePacket() {
 void Client::sendCostumeInfPacket(const char* body, const char* cap) {
 
     if (!sInstance) {
-        Logger::log("Static Instance is Null!\n");
+        LOG_ERROR(Net, "Static Instance is Null!\n");
         return;
     }
 
@@ -639,7 +760,7 @@ void Client::sendCostumeInfPacket(const char* body, const char* cap) {
 void Client::sendCaptureInfPacket(const PlayerActorHakoniwa* player) {
 
     if (!sInstance) {
-        Logger::log("Static Instance is Null!\n");
+        LOG_ERROR(Net, "Static Instance is Null!\n");
         return;
     }
 
@@ -668,7 +789,7 @@ void Client::sendCaptureInfPacket(const PlayerActorHakoniwa* player) {
 void Client::sendShineCollectPacket(int shineID) {
 
     if (!sInstance) {
-        Logger::log("Static Instance is Null!\n");
+        LOG_ERROR(Net, "Static Instance is Null!\n");
         return;
     }
 
@@ -702,48 +823,41 @@ void Client::updatePlayerInfo(PlayerInf *packet) {
         curInfo->isConnected = true;
     }
 
-    curInfo->playerPos = packet->playerPos;
+    PuppetSample& sample = curInfo->netSample.beginWrite();
+
+    sample.playerPos = packet->playerPos;
 
     // check if rotation is larger than zero and less than or equal to 1
     if(abs(packet->playerRot.x) > 0.f || abs(packet->playerRot.y) > 0.f || abs(packet->playerRot.z) > 0.f || abs(packet->playerRot.w) > 0.f) {
         if(abs(packet->playerRot.x) <= 1.f || abs(packet->playerRot.y) <= 1.f || abs(packet->playerRot.z) <= 1.f || abs(packet->playerRot.w) <= 1.f) {
-            curInfo->playerRot = packet->playerRot;
+            sample.playerRot = packet->playerRot;
         }
     }
 
-        if (packet->actName != PlayerAnims::Type::Unknown) {
-            strcpy(curInfo->curAnimStr, PlayerAnims::FindStr(packet->actName));
-            if (curInfo->curAnimStr[0] == '\0')
-                Logger::log("[ERROR] %s: actName was out of bounds: %d\n", __func__, packet->actName);
-        } else {
-            strcpy(curInfo->curAnimStr, "Wait");
-        }
+    if (packet->actName != PlayerAnims::Type::Unknown && PlayerAnims::FindStr(packet->actName)[0] == '\0')
+        LOG_ERROR(Net, "%s: actName was out of bounds: %d\n", __func__, packet->actName);
 
-        if(packet->subActName != PlayerAnims::Type::Unknown) {
-            strcpy(curInfo->curSubAnimStr, PlayerAnims::FindStr(packet->subActName));
-            if (curInfo->curSubAnimStr[0] == '\0')
-                Logger::log("[ERROR] %s: subActName was out of bounds: %d\n", __func__, packet->subActName);
-        } else {
-            strcpy(curInfo->curSubAnimStr, "");
-        }
+    if (packet->subActName != PlayerAnims::Type::Unknown && PlayerAnims::FindStr(packet->subActName)[0] == '\0')
+        LOG_ERROR(Net, "%s: subActName was out of bounds: %d\n", __func__, packet->subActName);
 
-    curInfo->curAnim = packet->actName;
-    curInfo->curSubAnim = packet->subActName;
+    sample.curAnim = packet->actName;
+    sample.curSubAnim = packet->subActName;
 
     for (size_t i = 0; i < 6; i++)
     {
         // weights can only be between 0 and 1
         if(packet->animBlendWeights[i] >= 0.f && packet->animBlendWeights[i] <= 1.f) {
-            curInfo->blendWeights[i] = packet->animBlendWeights[i];
+            sample.blendWeights[i] = packet->animBlendWeights[i];
         }
     }
 
     //TEMP
 
-    if(!curInfo->isCapThrow) {
-        curInfo->capPos = packet->playerPos;
+    if(!sample.isCapThrow) {
+        sample.capPos = packet->playerPos;
     }
 
+    curInfo->netSample.endWrite();
 }
 
 /**
@@ -756,12 +870,16 @@ void Client::updateHackCapInfo(HackCapInf *packet) {
     PuppetInfo* curInfo = findPuppetInfo(packet->mUserID, false);
 
     if (curInfo) {
-        curInfo->capPos = packet->capPos;
-        curInfo->capRot = packet->capQuat;
+        PuppetSample& sample = curInfo->netSample.beginWrite();
 
-        curInfo->isCapThrow = packet->isCapVisible;
+        sample.capPos = packet->capPos;
+        sample.capRot = packet->capQuat;
 
-        strcpy(curInfo->capAnim, packet->capAnim);
+        sample.isCapThrow = packet->isCapVisible;
+
+        sample.capAnim = packet->capAnim;
+
+        curInfo->netSample.endWrite();
     }
 }
 
@@ -778,11 +896,15 @@ void Client::updateCaptureInfo(CaptureInf* packet) {
         return;
     }
 
-    curInfo->isCaptured = strlen(packet->hackName) > 0;
+    PuppetSample& sample = curInfo->netSample.beginWrite();
 
-    if (curInfo->isCaptured) {
-        strcpy(curInfo->curHack, packet->hackName);
+    sample.isCaptured = strlen(packet->hackName) > 0;
+
+    if (sample.isCaptured) {
+        strncpy(sample.curHack, packet->hackName, sizeof(sample.curHack) - 1);
     }
+
+    curInfo->netSample.endWrite();
 }
 
 /**
@@ -798,8 +920,20 @@ void Client::updateCostumeInfo(CostumeInf *packet) {
         return;
     }
 
-    strcpy(curInfo->costumeBody, packet->bodyModel);
-    strcpy(curInfo->costumeHead, packet->capModel);
+    PuppetSample& sample = curInfo->netSample.beginWrite();
+
+    sample.costumeBodyType = packet->bodyType;
+    sample.costumeHeadType = packet->capType;
+
+    if (packet->hasModelNames()) {
+        strncpy(sample.costumeBody, packet->bodyModel, sizeof(sample.costumeBody) - 1);
+        strncpy(sample.costumeHead, packet->capModel, sizeof(sample.costumeHead) - 1);
+    } else {
+        sample.costumeBody[0] = '\0';
+        sample.costumeHead[0] = '\0';
+    }
+
+    curInfo->netSample.endWrite();
 }
 
 /**
@@ -808,10 +942,70 @@ void Client::updateCostumeInfo(CostumeInf *packet) {
  * @param packet 
  */
 void Client::updateShineInfo(ShineCollect* packet) {
-    if(collectedShineCount < curCollectedShines.size() - 1) {
-        curCollectedShines[collectedShineCount] = packet->shineId;
-        collectedShineCount++;
+    if ((u32)packet->shineId >= cMaxShineUid) {
+        LOG_WARN(Net, "Shine UID %d out of range.\n", packet->shineId);
+        return;
+    }
+
+    __atomic_fetch_or(&curCollectedShines.getWord(packet->shineId), curCollectedShines.makeMask(packet->shineId), __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief decodes the run length encoded bitmap of a ShineSync packet into curCollectedShines, the shines are then
+ * applied together by the next updateShines
+ * 
+ * @param packet 
+ */
+void Client::updateShineSync(ShineSync* packet) {
+    if (packet->mPacketSize < (int)sizeof(packet->bitmapSize)) {
+        NetStats::recordDrop(packet->mType, NetDropReason::Truncated);
+        LOG_WARN(Net, "Shine sync packet is too small (%d bytes).\n", (int)packet->mPacketSize);
+        return;
+    }
+
+    int runsSize = packet->mPacketSize - (int)sizeof(packet->bitmapSize);
+    int bitmapSize = packet->bitmapSize;
+
+    if (bitmapSize > cMaxShineUid / 8) {
+        LOG_WARN(Net, "Shine sync bitmap too large (%d bytes), ignoring shine UIDs past %d.\n", bitmapSize, cMaxShineUid);
+        bitmapSize = cMaxShineUid / 8;
+    }
+
+    int bytePos = 0;
+    int newCount = 0;
+
+    for (int i = 0; i < runsSize && bytePos < bitmapSize;) {
+        u8 control = packet->runs[i++];
+        u8 runType = control & ShineSync::cRunTypeMask;
+        int runLength = (control & ShineSync::cRunLengthMask) + 1;
+
+        if (runType == ShineSync::cRunLiteral) {
+            if (i + runLength > runsSize) {
+                LOG_WARN(Net, "Shine sync packet is truncated.\n");
+                break;
+            }
+        } else if (runType != ShineSync::cRunZero && runType != ShineSync::cRunOne) {
+            LOG_WARN(Net, "Unknown shine sync run: %02X\n", control);
+            break;
+        }
+
+        for (int j = 0; j < runLength && bytePos < bitmapSize; j++, bytePos++) {
+            u8 bits = runType == ShineSync::cRunLiteral ? packet->runs[i + j] : runType == ShineSync::cRunOne ? 0xFF : 0;
+
+            if (!bits)
+                continue;
+
+            auto& word = curCollectedShines.getWord(bytePos * 8);
+            u32 mask = (u32)bits << (bytePos % sizeof(word) * 8);
+
+            newCount += __builtin_popcount(mask & ~__atomic_fetch_or(&word, mask, __ATOMIC_RELAXED));
+        }
+
+        if (runType == ShineSync::cRunLiteral)
+            i += runLength;
     }
+
+    LOG_INFO(Net, "Received shine sync, %d new shines.\n", newCount);
 }
 
 /**
@@ -829,7 +1023,7 @@ void Client::updatePlayerConnect(PlayerConnect* packet) {
 
     if (curInfo->isConnected) {
 
-        Logger::log("Info is already being used by another connected player!\n");
+        LOG_WARN(Net, "Info is already being used by another connected player!\n");
         packet->mUserID.print("Connection ID");
         curInfo->playerID.print("Target Info");
 
@@ -837,6 +1031,17 @@ void Client::updatePlayerConnect(PlayerConnect* packet) {
 
         packet->mUserID.print("Player Connected! ID");
 
+        for (int i = 0; i < MAXPUPINDEX; i++) {
+            if (mPuppetInfoArr[i] == curInfo) {
+                // the slot may still be indexed under the player that used it before
+                if (!curInfo->playerID.isEmpty()) {
+                    mPuppetIndex.erase(curInfo->playerID);
+                }
+                mPuppetIndex.insert(packet->mUserID, i);
+                break;
+            }
+        }
+
         curInfo->playerID = packet->mUserID;
         curInfo->isConnected = true;
         strcpy(curInfo->puppetName, packet->clientName);
@@ -859,13 +1064,17 @@ void Client::updateGameInfo(GameInf *packet) {
 
     if(curInfo->isConnected) {
 
-        curInfo->scenarioNo = packet->scenarioNo;
+        PuppetSample& sample = curInfo->netSample.beginWrite();
+
+        sample.scenarioNo = packet->scenarioNo;
 
         if(strcmp(packet->stageName, "") != 0 && strlen(packet->stageName) > 3) {
-            strcpy(curInfo->stageName, packet->stageName);
+            strcpy(sample.stageName, packet->stageName);
         }
 
-        curInfo->is2D = packet->is2D;
+        sample.is2D = packet->is2D;
+
+        curInfo->netSample.endWrite();
     }
 }
 
@@ -879,7 +1088,7 @@ void Client::sendToStage(ChangeStagePacket* packet) {
 
         GameDataHolderAccessor accessor(mSceneInfo->mSceneObjHolder);
 
-        Logger::log("Sending Player to %s at Entrance %s in Scenario %d\n", packet->changeStage,
+        LOG_INFO(Net, "Sending Player to %s at Entrance %s in Scenario %d\n", packet->changeStage,
                      packet->changeID, packet->scenarioNo);
         
         ChangeStageInfo info(accessor.mData, packet->changeID, packet->changeStage, false, packet->scenarioNo, static_cast<ChangeStageInfo::SubScenarioType>(packet->subScenarioType));
@@ -902,8 +1111,13 @@ void Client::disconnectPlayer(PlayerDC *packet) {
     
     curInfo->isConnected = false;
 
-    curInfo->scenarioNo = -1;
-    strcpy(curInfo->stageName, "");
+    PuppetSample& sample = curInfo->netSample.beginWrite();
+
+    sample.scenarioNo = -1;
+    strcpy(sample.stageName, "");
+
+    curInfo->netSample.endWrite();
+
     curInfo->isInSameStage = false;
 
     mConnectCount--;
@@ -917,18 +1131,8 @@ void Client::disconnectPlayer(PlayerDC *packet) {
  * @return false 
  */
 bool Client::isShineCollected(int shineId) {
-
-    for (size_t i = 0; i < curCollectedShines.size(); i++)
-    {
-        if(curCollectedShines[i] >= 0) {
-            if(curCollectedShines[i] == shineId) {
-                return true;
-            }
-        }
-    }
-    
-    return false;
-
+    return (u32)shineId < cMaxShineUid &&
+           (__atomic_load_n(&curCollectedShines.getWord(shineId), __ATOMIC_RELAXED) & curCollectedShines.makeMask(shineId)) != 0;
 }
 
 /**
@@ -939,21 +1143,29 @@ bool Client::isShineCollected(int shineId) {
  */
 PuppetInfo* Client::findPuppetInfo(const nn::account::Uid& id, bool isFindAvailable) {
 
+    s8 slot = instance()->mPuppetIndex.find(id);
+
+    if (slot != UidIndex<MAXPUPINDEX * 2>::cInvalidSlot && slot < getMaxPlayerCount() - 1) {
+        return instance()->mPuppetInfoArr[slot];
+    }
+
     PuppetInfo *firstAvailable = nullptr;
 
-    for (size_t i = 0; i < getMaxPlayerCount() - 1; i++) {
+    // only new players need a free slot, so this scan only happens on connect
+    if (isFindAvailable) {
+        for (size_t i = 0; i < getMaxPlayerCount() - 1; i++) {
 
-        PuppetInfo* curInfo = instance()->mPuppetInfoArr[i];
+            PuppetInfo* curInfo = instance()->mPuppetInfoArr[i];
 
-        if (curInfo->playerID == id) {
-            return curInfo;
-        } else if (isFindAvailable && !firstAvailable && !curInfo->isConnected) {
-            firstAvailable = curInfo;
+            if (!curInfo->isConnected) {
+                firstAvailable = curInfo;
+                break;
+            }
         }
     }
 
     if (!firstAvailable) {
-        Logger::log("Unable to find Assigned Puppet for Player!\n");
+        LOG_ERROR(Net, "Unable to find Assigned Puppet for Player!\n");
         id.print("User ID");
     }
 
@@ -1044,7 +1256,7 @@ PuppetInfo *Client::getPuppetInfo(int idx) {
         PuppetInfo *curInfo = sInstance->mPuppetInfoArr[idx];
 
         if (!curInfo) {
-            Logger::log("Attempting to Access Puppet Out of Bounds! Value: %d\n", idx);
+            LOG_ERROR(Net, "Attempting to Access Puppet Out of Bounds! Value: %d\n", idx);
             return nullptr;
         }
 
@@ -1072,7 +1284,7 @@ PuppetInfo *Client::getPuppetInfo(const char *name) {
             }
         }
 
-        Logger::log("Unable to find Puppet with Name: %s\n", name);
+        LOG_ERROR(Net, "Unable to find Puppet with Name: %s\n", name);
         return nullptr;
 
     }else {
@@ -1085,8 +1297,9 @@ PuppetInfo *Client::getPuppetInfo(const char *name) {
  * 
  */
 void Client::resetCollectedShines() {
-    collectedShineCount = 0;
-    curCollectedShines.fill(-1);
+    for (int firstID = 0; firstID < cMaxShineUid; firstID += 32) {
+        __atomic_store_n(&curCollectedShines.getWord(firstID), 0, __ATOMIC_RELAXED);
+    }
 }
 
 /**
@@ -1095,12 +1308,8 @@ void Client::resetCollectedShines() {
  * @param shineId 
  */
 void Client::removeShine(int shineId) {
-    for (size_t i = 0; i < curCollectedShines.size(); i++)
-    {
-        if(curCollectedShines[i] == shineId) {
-            curCollectedShines[i] = -1;
-            collectedShineCount--;
-        }
+    if ((u32)shineId < cMaxShineUid) {
+        __atomic_fetch_and(&curCollectedShines.getWord(shineId), ~curCollectedShines.makeMask(shineId), __ATOMIC_RELAXED);
     }
 }
 
@@ -1111,7 +1320,15 @@ void Client::removeShine(int shineId) {
  * @return false 
  */
 bool Client::isNeedUpdateShines() {
-    return sInstance ? sInstance->collectedShineCount > 0 : false;
+    if (!sInstance)
+        return false;
+
+    for (int firstID = 0; firstID < cMaxShineUid; firstID += 32) {
+        if (__atomic_load_n(&sInstance->curCollectedShines.getWord(firstID), __ATOMIC_RELAXED))
+            return true;
+    }
+
+    return false;
 }
 
 /**
@@ -1120,7 +1337,7 @@ bool Client::isNeedUpdateShines() {
  */
 void Client::updateShines() {
     if (!sInstance) {
-        Logger::log("Client Null!\n");
+        LOG_ERROR(Net, "Client Null!\n");
         return;
     }
 
@@ -1130,38 +1347,41 @@ void Client::updateShines() {
     }
 
     GameDataHolderAccessor accessor(sInstance->mCurStageScene);
-    
-    for (size_t i = 0; i < sInstance->getCollectedShinesCount(); i++)
-    {
-        int shineID = sInstance->getShineID(i);
 
-        if(shineID < 0) continue;
+    tryBuildShineIndex(accessor);
 
-        Logger::log("Shine UID: %d\n", shineID);
+    // take the set bits a word at a time, anything the packet thread sets after a word was taken stays for the next update
+    for (int firstID = 0; firstID < cMaxShineUid; firstID += 32) {
+        u32 bits = __atomic_exchange_n(&sInstance->curCollectedShines.getWord(firstID), 0, __ATOMIC_RELAXED);
 
-        GameDataFile::HintInfo* shineInfo = CustomGameDataFunction::getHintInfoByUniqueID(accessor, shineID);
+        for (; bits; bits &= bits - 1) {
+            int shineID = firstID + __builtin_ctz(bits);
 
-        if (shineInfo) {
-            if (!GameDataFunction::isGotShine(accessor, shineInfo->mStageName.cstr(), shineInfo->mObjId.cstr())) {
+            LOG_DEBUG(Net, "Shine UID: %d\n", shineID);
 
-                Shine* stageShine = findStageShine(shineID);
-                
-                if (stageShine) {
+            GameDataFile::HintInfo* shineInfo = sInstance->mShineIndex.getHintInfo(shineID);
+
+            if (shineInfo) {
+                if (!GameDataFunction::isGotShine(accessor, shineInfo->mStageName.cstr(), shineInfo->mObjId.cstr())) {
+
+                    Shine* stageShine = findStageShine(shineID);
+
+                    if (stageShine) {
 
-                    if (al::isDead(stageShine)) {
-                        stageShine->makeActorAlive();
+                        if (al::isDead(stageShine)) {
+                            stageShine->makeActorAlive();
+                        }
+
+                        stageShine->getDirect();
+                        stageShine->onSwitchGet();
                     }
-                    
-                    stageShine->getDirect();
-                    stageShine->onSwitchGet();
-                }
 
-                accessor.mData->mGameDataFile->setGotShine(shineInfo);
+                    accessor.mData->mGameDataFile->setGotShine(shineInfo);
+                }
             }
         }
     }
-    
-    sInstance->resetCollectedShines();
+
     sInstance->mCurStageScene->mSceneLayout->startShineCountAnim(false);
     sInstance->mCurStageScene->mSceneLayout->updateCounterParts(); // updates shine chip layout to (maybe) prevent softlocks
 }
@@ -1169,12 +1389,25 @@ void Client::updateShines() {
 /**
  * @brief 
  * 
+ * @param player the local player, used to refresh PuppetQuery before the game modes update
  */
-void Client::update() {
+void Client::update(PlayerActorBase* player) {
+    PROFILE_SCOPE(ProfileZone::ClientUpdate);
+
     if (sInstance) {
+
+        sInstance->mFrameTimes[isBatchApply()].add(Time::deltaTime * 1000.f);
+
+        NetStats::update();
+
+        sInstance->applyPacketBatch();
+
+        sInstance->syncPuppetInfos();
         
         sInstance->mPuppetHolder->update();
 
+        PuppetQuery::update(player);
+
         if (isNeedUpdateShines()) {
             updateShines();
         }
@@ -1183,6 +1416,89 @@ void Client::update() {
     }
 }
 
+/**
+ * @brief remembers a cap action missing from CapAnims so it's only warned about once per stage
+ *
+ * @return true if the action wasn't warned about yet. once the set is full no more warnings are logged
+ */
+bool Client::tryAddWarnedCapAnim(const char* actionName) {
+    u32 hash = crc32::HashStr(actionName);
+
+    for (int i = 0; i < mWarnedCapAnimCount; i++) {
+        if (mWarnedCapAnims[i] == hash)
+            return false;
+    }
+
+    if (mWarnedCapAnimCount >= cMaxWarnedCapAnims)
+        return false;
+
+    mWarnedCapAnims[mWarnedCapAnimCount++] = hash;
+    return true;
+}
+
+/**
+ * @brief applies any staged packets and syncs every puppet info outside of update, so puppets created
+ * while a stage loads read the costume and state that arrived since the last frame
+ */
+void Client::syncPuppetInfosForInit() {
+    if (sInstance) {
+        sInstance->applyPacketBatch();
+        sInstance->syncPuppetInfos();
+    }
+}
+
+/**
+ * @brief copies the latest sample published by the read thread into each puppet info, so everything
+ * running on the game thread this frame sees the same consistent state
+ */
+void Client::syncPuppetInfos() {
+    for (size_t i = 0; i < MAXPUPINDEX; i++) {
+        PuppetInfo* curInfo = mPuppetInfoArr[i];
+
+        PuppetSample sample;
+
+        if (!curInfo->netSample.tryRead(sample, curInfo->netSampleSeq)) {
+            continue;
+        }
+
+        curInfo->playerPos = sample.playerPos;
+        curInfo->playerRot = sample.playerRot;
+
+        curInfo->scenarioNo = sample.scenarioNo;
+        strcpy(curInfo->stageName, sample.stageName);
+
+        if (curInfo->curAnim != sample.curAnim || curInfo->curAnimStr[0] == '\0') {
+            if (sample.curAnim != PlayerAnims::Type::Unknown) {
+                strcpy(curInfo->curAnimStr, PlayerAnims::FindStr(sample.curAnim));
+            } else {
+                strcpy(curInfo->curAnimStr, "Wait");
+            }
+        }
+
+        if (curInfo->curSubAnim != sample.curSubAnim) {
+            strcpy(curInfo->curSubAnimStr, PlayerAnims::FindStr(sample.curSubAnim));
+        }
+
+        curInfo->curAnim = sample.curAnim;
+        curInfo->curSubAnim = sample.curSubAnim;
+        memcpy(curInfo->blendWeights, sample.blendWeights, sizeof(curInfo->blendWeights));
+        curInfo->is2D = sample.is2D;
+
+        curInfo->capPos = sample.capPos;
+        curInfo->capRot = sample.capRot;
+        curInfo->capAnim = sample.capAnim;
+        curInfo->isCapThrow = sample.isCapThrow;
+
+        curInfo->isCaptured = sample.isCaptured;
+        strcpy(curInfo->curHack, sample.curHack);
+
+        curInfo->costumeBodyType = sample.costumeBodyType;
+        curInfo->costumeHeadType = sample.costumeHeadType;
+        strcpy(curInfo->costumeBody, sample.costumeBody);
+        strcpy(curInfo->costumeHead, sample.costumeHead);
+    }
+}
+
 /**
  * @brief 
  * 
@@ -1190,7 +1506,8 @@ void Client::update() {
 void Client::clearArrays() {
     if(sInstance) {
         sInstance->mPuppetHolder->clearPuppets();
-        sInstance->mShineArray.clear();
+        sInstance->mShineIndex.clear();
+        sInstance->mWarnedCapAnimCount = 0;
 
     }
 }
@@ -1288,7 +1605,7 @@ void Client::setLastUsedPort(const int port) {
 void Client::setSceneInfo(const al::ActorInitInfo& initInfo, const StageScene *stageScene) {
 
     if (!sInstance) {
-        Logger::log("Client Null!\n");
+        LOG_ERROR(Net, "Client Null!\n");
         return;
     }
 
@@ -1300,48 +1617,47 @@ void Client::setSceneInfo(const al::ActorInitInfo& initInfo, const StageScene *s
 }
 
 /**
- * @brief stores shine pointer supplied into a ptr array if space is available, and shine is not collected.
+ * @brief builds the shine ID index from the save file's hint list, once per stage
+ * 
+ * @param accessor 
+ */
+void Client::tryBuildShineIndex(GameDataHolderAccessor accessor) {
+    if (sInstance && !sInstance->mShineIndex.isBuilt()) {
+        sInstance->mShineIndex.build(accessor.mData->mGameDataFile->mShineHintList);
+    }
+}
+
+/**
+ * @brief stores shine pointer supplied in the shine index under its unique ID, if shine is not collected.
  * 
  * @param shine 
  * @return true if shine was able to be successfully stored
- * @return false if shine is already collected, or ptr array is full
+ * @return false if shine is already collected
  */
 bool Client::tryRegisterShine(Shine* shine) {
     if (sInstance) {
-        if (!sInstance->mShineArray.isFull()) {
-            if (!shine->isGot()) {
-                sInstance->mShineArray.pushBack(shine);
-                return true;
-            }
+        if (!shine->isGot()) {
+            GameDataHolderAccessor accessor(shine);
+
+            tryBuildShineIndex(accessor);
+
+            auto hintInfo = CustomGameDataFunction::getHintInfoByIndex(accessor, shine->mShineIdx);
+
+            sInstance->mShineIndex.setShine(hintInfo->mUniqueID, shine);
+            return true;
         }
     }
     return false;
 }
 
 /**
- * @brief finds the actor pointer stored in the shine ptr array based off shine ID
+ * @brief finds the actor pointer stored in the shine index based off shine ID
  * 
  * @param shineID Unique ID used for shine actor
- * @return Shine* if shine ptr array contains actor with supplied shine ID.
+ * @return Shine* if a shine actor with supplied shine ID was registered in the current stage.
  */
 Shine* Client::findStageShine(int shineID) {
-    if (sInstance) {
-        for (int i = 0; i < sInstance->mShineArray.size(); i++) {
-
-            Shine* curShine = sInstance->mShineArray[i];
-
-            if (curShine) {
-
-                auto hintInfo =
-                    CustomGameDataFunction::getHintInfoByIndex(curShine, curShine->mShineIdx);
-                
-                if (hintInfo->mUniqueID == shineID) {
-                    return curShine;
-                }
-            }
-        }
-    }
-    return nullptr;
+    return sInstance ? sInstance->mShineIndex.getShine(shineID) : nullptr;
 }
 
 void Client::showConnectError(const char16_t* msg) {
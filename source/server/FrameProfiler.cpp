@@ -0,0 +1,82 @@
+#include "server/FrameProfiler.hpp"
+
+#if PROFILE
+
+#include <algorithm>
+
+std::atomic<u32> FrameProfiler::sCurFrameNs[(int)ProfileZone::End];
+std::atomic<u32> FrameProfiler::sCurFrameCalls[(int)ProfileZone::End];
+u32 FrameProfiler::sFrameNs[(int)ProfileZone::End][cFrameCount] = {};
+u32 FrameProfiler::sFrameCalls[(int)ProfileZone::End] = {};
+int FrameProfiler::sFrameIndex = 0;
+int FrameProfiler::sFramesFilled = 0;
+
+void FrameProfiler::beginFrame() {
+    sFrameIndex = (sFrameIndex + 1) % cFrameCount;
+
+    if (sFramesFilled < cFrameCount) {
+        sFramesFilled++;
+    }
+
+    for (int i = 0; i < (int)ProfileZone::End; i++) {
+        sFrameNs[i][sFrameIndex] = sCurFrameNs[i].exchange(0, std::memory_order_relaxed);
+        sFrameCalls[i] = sCurFrameCalls[i].exchange(0, std::memory_order_relaxed);
+    }
+}
+
+void FrameProfiler::addTime(ProfileZone zone, const sead::TickSpan& span) {
+    sCurFrameNs[(int)zone].fetch_add((u32)span.toNanoSeconds(), std::memory_order_relaxed);
+    sCurFrameCalls[(int)zone].fetch_add(1, std::memory_order_relaxed);
+}
+
+void FrameProfiler::calcSummary(ProfileSummary* out, ProfileZone zone) {
+    *out = ProfileSummary();
+
+    if (!sFramesFilled) {
+        return;
+    }
+
+    const u32* frames = sFrameNs[(int)zone];
+
+    // the ring isn't ordered once it wraps, so a full ring can be used as is, otherwise take the filled part
+    u32 sorted[cFrameCount];
+    int count = sFramesFilled;
+    int start = sFramesFilled < cFrameCount ? 1 : 0;
+
+    std::copy(frames + start, frames + start + count, sorted);
+
+    u64 total = 0;
+    for (int i = 0; i < count; i++) {
+        total += sorted[i];
+    }
+
+    int p99Index = (count * 99) / 100;
+    std::nth_element(sorted, sorted + p99Index, sorted + count);
+
+    out->minUs = *std::min_element(sorted, sorted + count) * 0.001f;
+    out->avgUs = (float)total / count * 0.001f;
+    out->p99Us = sorted[p99Index] * 0.001f;
+    out->lastUs = frames[sFrameIndex] * 0.001f;
+    out->lastCalls = sFrameCalls[(int)zone];
+}
+
+const char* FrameProfiler::getZoneName(ProfileZone zone) {
+    switch (zone) {
+    case ProfileZone::ClientUpdate:
+        return "Client::update";
+    case ProfileZone::PuppetHolderUpdate:
+        return "PuppetHolder::update";
+    case ProfileZone::PuppetControl:
+        return "PuppetActor::control";
+    case ProfileZone::GameModeUpdate:
+        return "GameModeManager::update";
+    case ProfileZone::NameTagUpdate:
+        return "NameTag::update";
+    case ProfileZone::DrawMain:
+        return "drawMainHook";
+    default:
+        return "Unknown";
+    }
+}
+
+#endif
@@ -0,0 +1,148 @@
+#include "server/NetStats.hpp"
+#include "logger.hpp"
+#include "nn/os.h"
+
+PacketTypeStats NetStats::sTypeStats[PacketType::End];
+std::atomic<u32> NetStats::sDrops[(int)NetDropReason::End];
+std::atomic<u32> NetStats::sQueueHighWater[(int)NetQueue::End];
+std::atomic<u32> NetStats::sReconnects = 0;
+std::atomic<u32> NetStats::sReconnectFails = 0;
+
+u32 NetStats::sWindowIn[cWindowSeconds + 1][PacketType::End] = {};
+u32 NetStats::sWindowOut[cWindowSeconds + 1][PacketType::End] = {};
+int NetStats::sWindowIndex = 0;
+int NetStats::sWindowFilled = 0;
+u64 NetStats::sLastSampleTick = 0;
+int NetStats::sSecondsSinceDump = 0;
+float NetStats::sRateIn[PacketType::End] = {};
+float NetStats::sRateOut[PacketType::End] = {};
+bool NetStats::sIsPeriodicDump = false;
+
+void NetStats::recordRecv(PacketType type, u32 size) {
+    PacketTypeStats& stats = sTypeStats[toIndex(type)];
+    stats.packetsIn.fetch_add(1, std::memory_order_relaxed);
+    stats.bytesIn.fetch_add(size, std::memory_order_relaxed);
+}
+
+void NetStats::recordSend(PacketType type, u32 size) {
+    PacketTypeStats& stats = sTypeStats[toIndex(type)];
+    stats.packetsOut.fetch_add(1, std::memory_order_relaxed);
+    stats.bytesOut.fetch_add(size, std::memory_order_relaxed);
+}
+
+void NetStats::recordDrop(PacketType type, NetDropReason reason) {
+    sTypeStats[toIndex(type)].drops.fetch_add(1, std::memory_order_relaxed);
+    sDrops[(int)reason].fetch_add(1, std::memory_order_relaxed);
+}
+
+void NetStats::recordQueueCount(NetQueue queue, u32 count) {
+    std::atomic<u32>& highWater = sQueueHighWater[(int)queue];
+    u32 curHighWater = highWater.load(std::memory_order_relaxed);
+
+    while (count > curHighWater && !highWater.compare_exchange_weak(curHighWater, count, std::memory_order_relaxed)) {}
+}
+
+void NetStats::recordReconnect(bool isSuccess) {
+    if (isSuccess) {
+        sReconnects.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        sReconnectFails.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void NetStats::update() {
+    u64 now = nn::os::GetSystemTick();
+
+    if (sLastSampleTick && now - sLastSampleTick < nn::os::GetSystemTickFrequency()) {
+        return;
+    }
+
+    sLastSampleTick = now;
+
+    // the window holds the cumulative counts of the last cWindowSeconds + 1 samples, so the rate is the
+    // difference between the newest and oldest sample
+    sWindowIndex = (sWindowIndex + 1) % (cWindowSeconds + 1);
+
+    for (int i = 0; i < PacketType::End; i++) {
+        sWindowIn[sWindowIndex][i] = sTypeStats[i].packetsIn.load(std::memory_order_relaxed);
+        sWindowOut[sWindowIndex][i] = sTypeStats[i].packetsOut.load(std::memory_order_relaxed);
+    }
+
+    if (sWindowFilled < cWindowSeconds) {
+        sWindowFilled++;
+    }
+
+    int oldestIndex = (sWindowIndex + cWindowSeconds + 1 - sWindowFilled) % (cWindowSeconds + 1);
+
+    for (int i = 0; i < PacketType::End; i++) {
+        sRateIn[i] = (float)(sWindowIn[sWindowIndex][i] - sWindowIn[oldestIndex][i]) / sWindowFilled;
+        sRateOut[i] = (float)(sWindowOut[sWindowIndex][i] - sWindowOut[oldestIndex][i]) / sWindowFilled;
+    }
+
+    if (sIsPeriodicDump && ++sSecondsSinceDump >= cDumpIntervalSeconds) {
+        sSecondsSinceDump = 0;
+        dumpToLog();
+    }
+}
+
+void NetStats::dumpToLog() {
+    LOG_INFO(Net, "---- Net Stats ----\n");
+
+    for (int i = 0; i < PacketType::End; i++) {
+        const PacketTypeStats& stats = sTypeStats[i];
+
+        u32 packetsIn = stats.packetsIn.load(std::memory_order_relaxed);
+        u32 packetsOut = stats.packetsOut.load(std::memory_order_relaxed);
+        u32 drops = stats.drops.load(std::memory_order_relaxed);
+
+        if (!packetsIn && !packetsOut && !drops) {
+            continue;
+        }
+
+        LOG_INFO(Net, "%s: In %u (%u B, %.1f/s) Out %u (%u B, %.1f/s) Drops %u\n", packetNames[i], packetsIn,
+                    stats.bytesIn.load(std::memory_order_relaxed), sRateIn[i], packetsOut,
+                    stats.bytesOut.load(std::memory_order_relaxed), sRateOut[i], drops);
+    }
+
+    for (int i = 0; i < (int)NetDropReason::End; i++) {
+        LOG_INFO(Net, "Drops (%s): %u\n", getDropReasonName((NetDropReason)i), getDropCount((NetDropReason)i));
+    }
+
+    for (int i = 0; i < (int)NetQueue::End; i++) {
+        LOG_INFO(Net, "%s Queue High Water: %u\n", getQueueName((NetQueue)i), getQueueHighWater((NetQueue)i));
+    }
+
+    LOG_INFO(Net, "Reconnects: %u (%u failed)\n", getReconnectCount(), getReconnectFailCount());
+}
+
+const char* NetStats::getDropReasonName(NetDropReason reason) {
+    switch (reason) {
+    case NetDropReason::RecvQueueFull:
+        return "Recv Queue Full";
+    case NetDropReason::SendQueueFull:
+        return "Send Queue Full";
+    case NetDropReason::NotConnected:
+        return "Not Connected";
+    case NetDropReason::SendFailed:
+        return "Send Failed";
+    case NetDropReason::InvalidHeader:
+        return "Invalid Header";
+    case NetDropReason::Truncated:
+        return "Truncated";
+    default:
+        return "Unknown";
+    }
+}
+
+const char* NetStats::getQueueName(NetQueue queue) {
+    switch (queue) {
+    case NetQueue::Recv:
+        return "Recv";
+    case NetQueue::Send:
+        return "Send";
+    case NetQueue::Apply:
+        return "Apply";
+    default:
+        return "Unknown";
+    }
+}
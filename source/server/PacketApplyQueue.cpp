@@ -0,0 +1,99 @@
+#include "server/PacketApplyQueue.hpp"
+#include <stdlib.h>
+#include <string.h>
+
+PacketApplyQueue::~PacketApplyQueue() {
+    for (int i = 0; i < mCount; i++) {
+        free(mPackets[i]);
+    }
+
+    free(mPackets);
+}
+
+bool PacketApplyQueue::push(Packet* packet) {
+    if (tryCoalesce(packet)) {
+        free(packet);
+        mCoalesceCount++;
+        return true;
+    }
+
+    if (mCount == mCapacity && !tryGrow())
+        return false;
+
+    mPackets[mCount++] = packet;
+
+    if (packet->mType != PacketType::PLAYERINF && packet->mType != PacketType::HACKCAPINF)
+        return true;
+
+    // remember it so newer state from the same player can be copied over it
+    Pending* pending = nullptr;
+
+    for (int i = 0; i < mPendingCount && !pending; i++) {
+        if (mPending[i].userID == packet->mUserID)
+            pending = &mPending[i];
+    }
+
+    if (!pending) {
+        if (mPendingCount == cMaxPendingPlayers)
+            return true;
+
+        pending = &mPending[mPendingCount++];
+        pending->userID = packet->mUserID;
+        pending->playerInf = nullptr;
+        pending->hackCapInf = nullptr;
+    }
+
+    if (packet->mType == PacketType::PLAYERINF) {
+        pending->playerInf = packet;
+    } else {
+        pending->hackCapInf = packet;
+    }
+
+    return true;
+}
+
+bool PacketApplyQueue::tryCoalesce(Packet* packet) {
+    if (packet->mType != PacketType::PLAYERINF && packet->mType != PacketType::HACKCAPINF)
+        return false;
+
+    for (int i = 0; i < mPendingCount; i++) {
+        if (!(mPending[i].userID == packet->mUserID))
+            continue;
+
+        Packet* staged = packet->mType == PacketType::PLAYERINF ? mPending[i].playerInf : mPending[i].hackCapInf;
+
+        if (!staged || staged->mPacketSize != packet->mPacketSize)
+            return false;
+
+        memcpy((void*)staged, (const void*)packet, sizeof(Packet) + packet->mPacketSize);
+        return true;
+    }
+
+    return false;
+}
+
+bool PacketApplyQueue::tryGrow() {
+    int capacity = mCapacity ? mCapacity * 2 : cInitialCapacity;
+    Packet** packets = (Packet**)realloc(mPackets, capacity * sizeof(Packet*));
+
+    if (!packets)
+        return false;
+
+    mPackets = packets;
+    mCapacity = capacity;
+    return true;
+}
+
+void PacketApplyQueue::forgetPlayer(const nn::account::Uid& userID) {
+    for (int i = 0; i < mPendingCount; i++) {
+        if (mPending[i].userID == userID) {
+            mPending[i] = mPending[--mPendingCount];
+            return;
+        }
+    }
+}
+
+void PacketApplyQueue::clear() {
+    mCount = 0;
+    mPendingCount = 0;
+}
@@ -0,0 +1,82 @@
+#include "server/PuppetQuery.hpp"
+#include "server/Client.hpp"
+#include "actors/PuppetActor.h"
+#include "algorithms/BatchMath.h"
+#include "al/util.hpp"
+#include "al/util/GraphicsUtil.h"
+#include "game/Player/PlayerActorHakoniwa.h"
+#include "gfx/seadCamera.h"
+#include <float.h>
+
+static_assert(PuppetQuery::cMaxPuppets == MAXPUPINDEX, "PuppetQuery must hold every puppet slot");
+
+bool PuppetQuery::sIsValid = false;
+int PuppetQuery::sCount = 0;
+u32 PuppetQuery::sFrameCount = 0;
+PuppetQueryResult PuppetQuery::sResults[cMaxPuppets];
+// returned for puppets outside the holder, far enough away that nothing treats them as near
+PuppetQueryResult PuppetQuery::sEmptyResult = {FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX, false, false};
+
+void PuppetQuery::update(PlayerActorBase* player) {
+    PuppetHolder* holder = Client::getPuppetHolder();
+
+    sFrameCount++;
+
+    sIsValid = player && holder;
+    sCount = sIsValid ? holder->getSize() : 0;
+
+    if (sCount > cMaxPuppets)
+        sCount = cMaxPuppets;
+
+    if (!sIsValid) {
+        return;
+    }
+
+    // yukimaru (the racing minigame player) has no dimension keeper
+    bool isPlayer2D = player->getPlayerInfo() ? ((PlayerActorHakoniwa*)player)->mDimKeeper->is2DModel : false;
+    const sead::Vector3f& playerTrans = al::getTrans(player);
+    const sead::Vector3f& cameraPos = al::getLookAtCamera(player, 0)->getPos();
+
+    float posX[cMaxPuppets], posY[cMaxPuppets], posZ[cMaxPuppets];
+    float modelX[cMaxPuppets], modelY[cMaxPuppets], modelZ[cMaxPuppets];
+
+    for (int i = 0; i < sCount; i++) {
+        PuppetActor* puppet = holder->getPuppetActor(i);
+        PuppetInfo* info = puppet->getInfo();
+        PuppetQueryResult& result = sResults[i];
+
+        result.isActive = info->isConnected && info->isInSameStage;
+        result.isSame2D = info->is2D == isPlayer2D;
+
+        posX[i] = info->playerPos.x;
+        posY[i] = info->playerPos.y;
+        posZ[i] = info->playerPos.z;
+
+        const sead::Vector3f& modelTrans = al::getTrans(puppet->getCurrentModel());
+        modelX[i] = modelTrans.x;
+        modelY[i] = modelTrans.y;
+        modelZ[i] = modelTrans.z;
+    }
+
+    float distSq[cMaxPuppets], dist[cMaxPuppets];
+    float modelDistSq[cMaxPuppets], modelDist[cMaxPuppets];
+    float cameraDistSq[cMaxPuppets];
+
+    batch::calcDistanceSq(distSq, posX, posY, posZ, playerTrans, sCount);
+    batch::calcDistanceSq(modelDistSq, modelX, modelY, modelZ, playerTrans, sCount);
+    batch::calcDistanceSq(cameraDistSq, modelX, modelY, modelZ, cameraPos, sCount);
+    batch::calcSqrt(dist, distSq, sCount);
+    batch::calcSqrt(modelDist, modelDistSq, sCount);
+
+    for (int i = 0; i < sCount; i++) {
+        sResults[i].distSq = distSq[i];
+        sResults[i].dist = dist[i];
+        sResults[i].modelDistSq = modelDistSq[i];
+        sResults[i].modelDist = modelDist[i];
+        sResults[i].cameraDistSq = cameraDistSq[i];
+    }
+}
+
+const PuppetQueryResult& PuppetQuery::get(const PuppetActor* puppet) {
+    return get(puppet->getPuppetIndex());
+}
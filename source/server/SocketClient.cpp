@@ -10,13 +10,15 @@
 #include "nn/socket.h"
 #include "packets/Packet.h"
 #include "server/Client.hpp"
+#include "server/NetStats.hpp"
+#include "server/ThreadConfig.hpp"
 #include "thread/seadMessageQueue.h"
 #include "types.h"
 
 SocketClient::SocketClient(const char* name, sead::Heap* heap) : mHeap(heap), SocketBase(name) {
 
-    mRecvThread = new al::AsyncFunctorThread("SocketRecvThread", al::FunctorV0M<SocketClient*, SocketThreadFunc>(this, &SocketClient::recvFunc), 0, 0x1000, {0});
-    mSendThread = new al::AsyncFunctorThread("SocketSendThread", al::FunctorV0M<SocketClient*, SocketThreadFunc>(this, &SocketClient::sendFunc), 0, 0x1000, {0});
+    mRecvThread = ThreadConfig::createThread(NetThread::SocketRecv, al::FunctorV0M<SocketClient*, SocketThreadFunc>(this, &SocketClient::recvFunc));
+    mSendThread = ThreadConfig::createThread(NetThread::SocketSend, al::FunctorV0M<SocketClient*, SocketThreadFunc>(this, &SocketClient::sendFunc));
     
     mRecvQueue.allocate(maxBufSize, mHeap);
     mSendQueue.allocate(maxBufSize, mHeap);
@@ -30,7 +32,7 @@ nn::Result SocketClient::init(const char* ip, u16 port) {
     in_addr  hostAddress   = { 0 };
     sockaddr serverAddress = { 0 };
 
-    Logger::log("SocketClient::init: %s:%d sock %s\n", ip, port, getStateChar());
+    LOG_INFO(Net, "SocketClient::init: %s:%d sock %s\n", ip, port, getStateChar());
 
     nn::nifm::Initialize();
     nn::nifm::SubmitNetworkRequest();
@@ -40,7 +42,7 @@ nn::Result SocketClient::init(const char* ip, u16 port) {
     // emulators (ryujinx) make this return false always, so skip it during init
     #ifndef EMU
     if (!nn::nifm::IsNetworkAvailable()) {
-        Logger::log("Network Unavailable.\n");
+        LOG_ERROR(Net, "Network Unavailable.\n");
         this->socket_log_state = SOCKET_LOG_UNAVAILABLE;
         this->socket_errno = nn::socket::GetLastErrno();
         return -1;
@@ -48,14 +50,14 @@ nn::Result SocketClient::init(const char* ip, u16 port) {
     #endif
 
     if ((this->socket_log_socket = nn::socket::Socket(2, 1, 6)) < 0) {
-        Logger::log("Socket Unavailable.\n");
+        LOG_ERROR(Net, "Socket Unavailable.\n");
         this->socket_errno = nn::socket::GetLastErrno();
         this->socket_log_state = SOCKET_LOG_UNAVAILABLE;
         return -1;
     }
 
     if (! this->stringToIPAddress(this->sock_ip, &hostAddress)) {
-        Logger::log("IP address is invalid or hostname not resolveable.\n");
+        LOG_ERROR(Net, "IP address is invalid or hostname not resolveable.\n");
         this->socket_errno = nn::socket::GetLastErrno();
         this->socket_log_state = SOCKET_LOG_UNAVAILABLE;
         return -1;
@@ -72,7 +74,7 @@ nn::Result SocketClient::init(const char* ip, u16 port) {
     nn::Result result;
     
     if((result = nn::socket::Connect(this->socket_log_socket, &serverAddress, sizeof(serverAddress))).isFailure()) {
-        Logger::log("Socket Connection Failed!\n");
+        LOG_ERROR(Net, "Socket Connection Failed!\n");
         this->socket_errno = nn::socket::GetLastErrno();
         this->socket_log_state = SOCKET_LOG_UNAVAILABLE;
         return result;
@@ -80,7 +82,7 @@ nn::Result SocketClient::init(const char* ip, u16 port) {
 
     this->socket_log_state = SOCKET_LOG_CONNECTED;
 
-    Logger::log("Socket fd: %d\n", socket_log_socket);
+    LOG_DEBUG(Net, "Socket fd: %d\n", socket_log_socket);
 
     startThreads();  // start recv and send threads after sucessful connection
 
@@ -113,12 +115,14 @@ bool SocketClient::send(Packet *packet) {
     int valread = 0;
 
     if (packet->mType != PLAYERINF && packet->mType != HACKCAPINF)
-        Logger::log("Sending packet: %s\n", packetNames[packet->mType]);
+        LOG_TRACE(Net, "Sending packet: %s\n", packetNames[packet->mType]);
 
     if ((valread = nn::socket::Send(this->socket_log_socket, buffer, packet->mPacketSize + sizeof(Packet), 0) > 0)) {
+        NetStats::recordSend(packet->mType, packet->mPacketSize + sizeof(Packet));
         return true;
     } else {
-        Logger::log("Failed to Fully Send Packet! Result: %d Type: %s Packet Size: %d\n", valread, packetNames[packet->mType], packet->mPacketSize);
+        NetStats::recordDrop(packet->mType, NetDropReason::SendFailed);
+        LOG_ERROR(Net, "Failed to Fully Send Packet! Result: %d Type: %s Packet Size: %d\n", valread, packetNames[packet->mType], packet->mPacketSize);
         this->socket_errno = nn::socket::GetLastErrno();
         this->tryReconnect();
         return false;
@@ -129,7 +133,7 @@ bool SocketClient::send(Packet *packet) {
 bool SocketClient::recv() {
 
     if (this->socket_log_state != SOCKET_LOG_CONNECTED) {
-        Logger::log("Unable To Receive! Socket Not Connected.\n");
+        LOG_ERROR(Net, "Unable To Receive! Socket Not Connected.\n");
         this->socket_errno = nn::socket::GetLastErrno();
         return this->tryReconnect();
     }
@@ -151,7 +155,7 @@ bool SocketClient::recv() {
             if(this->socket_errno==11){
                 return true;
             } else {
-                Logger::log("Header Read Failed! Value: %d Total Read: %d\n", result, valread);
+                LOG_ERROR(Net, "Header Read Failed! Value: %d Total Read: %d\n", result, valread);
                 return this->tryReconnect(); // if we sucessfully reconnect, we dont want 
             }
         }
@@ -161,18 +165,19 @@ bool SocketClient::recv() {
         Packet* header = reinterpret_cast<Packet*>(headerBuf);
 
         int fullSize = header->mPacketSize + sizeof(Packet);
+        int maxSize = header->mType == PacketType::SHINESYNC ? MAXSHINESYNCSIZE : MAXPACKSIZE;
 
         if (header->mType > PacketType::UNKNOWN && header->mType < PacketType::End &&
-            fullSize <= MAXPACKSIZE && fullSize > 0 && valread == sizeof(Packet)) {
+            fullSize <= maxSize && fullSize > 0 && valread == sizeof(Packet)) {
 
             if (header->mType != PLAYERINF && header->mType != HACKCAPINF) {
-                Logger::log("Received packet (from %02X%02X):", header->mUserID.data[0],
+                LOG_TRACE(Net, "Received packet (from %02X%02X):", header->mUserID.data[0],
                             header->mUserID.data[1]);
                 Logger::disableName();
-                Logger::log(" Size: %d", header->mPacketSize);
-                Logger::log(" Type: %d", header->mType);
+                LOG_TRACE(Net, " Size: %d", header->mPacketSize);
+                LOG_TRACE(Net, " Type: %d", header->mType);
                 if(packetNames[header->mType])
-                    Logger::log(" Type String: %s\n", packetNames[header->mType]);
+                    LOG_TRACE(Net, " Type String: %s\n", packetNames[header->mType]);
                 Logger::enableName();
             }
 
@@ -193,26 +198,31 @@ bool SocketClient::recv() {
                         valread += result;
                     } else {
                         free(packetBuf);
-                        Logger::log("Packet Read Failed! Value: %d\nPacket Size: %d\nPacket Type: %s\n", result, header->mPacketSize, packetNames[header->mType]);
+                        LOG_ERROR(Net, "Packet Read Failed! Value: %d\nPacket Size: %d\nPacket Type: %s\n", result, header->mPacketSize, packetNames[header->mType]);
                         return this->tryReconnect();
                     }
                 }
 
                 Packet* packet = reinterpret_cast<Packet*>(packetBuf);
 
+                NetStats::recordRecv(packet->mType, fullSize);
+
                 if (!mRecvQueue.isFull()) {
                     mRecvQueue.push((s64)packet, sead::MessageQueue::BlockType::NonBlocking);
+                    NetStats::recordQueueCount(NetQueue::Recv, mRecvQueue.getCount());
                 } else {
+                    NetStats::recordDrop(packet->mType, NetDropReason::RecvQueueFull);
                     free(packetBuf);
                 }
             }
         } else {
-            Logger::log("Failed to aquire valid data! Packet Type: %d Full Packet Size %d valread size: %d", header->mType, fullSize, valread);
+            NetStats::recordDrop(header->mType, NetDropReason::InvalidHeader);
+            LOG_ERROR(Net, "Failed to aquire valid data! Packet Type: %d Full Packet Size %d valread size: %d", header->mType, fullSize, valread);
         }
         
         return true;
     } else {  // if we error'd, close the socket
-        Logger::log("valread was zero! Disconnecting.\n");
+        LOG_ERROR(Net, "valread was zero! Disconnecting.\n");
         this->socket_errno = nn::socket::GetLastErrno();
         return this->tryReconnect();
     }
@@ -221,13 +231,13 @@ bool SocketClient::recv() {
 // prints packet to debug logger
 void SocketClient::printPacket(Packet *packet) {
     packet->mUserID.print();
-    Logger::log("Type: %s\n", packetNames[packet->mType]);
+    LOG_TRACE(Net, "Type: %s\n", packetNames[packet->mType]);
 
     switch (packet->mType)
     {
     case PacketType::PLAYERINF:
-        Logger::log("Pos X: %f Pos Y: %f Pos Z: %f\n", ((PlayerInf*)packet)->playerPos.x, ((PlayerInf*)packet)->playerPos.y, ((PlayerInf*)packet)->playerPos.z);
-        Logger::log("Rot X: %f Rot Y: %f Rot Z: %f\nRot W: %f\n", ((PlayerInf*)packet)->playerRot.x, ((PlayerInf*)packet)->playerRot.y, ((PlayerInf*)packet)->playerRot.z, ((PlayerInf*)packet)->playerRot.w);
+        LOG_TRACE(Net, "Pos X: %f Pos Y: %f Pos Z: %f\n", ((PlayerInf*)packet)->playerPos.x, ((PlayerInf*)packet)->playerPos.y, ((PlayerInf*)packet)->playerPos.z);
+        LOG_TRACE(Net, "Rot X: %f Rot Y: %f Rot Z: %f\nRot W: %f\n", ((PlayerInf*)packet)->playerRot.x, ((PlayerInf*)packet)->playerRot.y, ((PlayerInf*)packet)->playerRot.z, ((PlayerInf*)packet)->playerRot.w);
         break;
     default:
         break;
@@ -236,26 +246,29 @@ void SocketClient::printPacket(Packet *packet) {
 
 bool SocketClient::tryReconnect() {
 
-    Logger::log("Attempting to Reconnect.\n");
+    LOG_WARN(Net, "Attempting to Reconnect.\n");
 
     if (closeSocket()) { // unfortunately we cannot use the same fd from the previous connection, so close the socket entirely and attempt a new connection.
         if (init(sock_ip, port).isSuccess()) { // call init again
-            Logger::log("Reconnect Successful.\n");
+            LOG_INFO(Net, "Reconnect Successful.\n");
+            NetStats::recordReconnect(true);
             return true;
         }
     }
 
+    NetStats::recordReconnect(false);
+
     return false;
 }
 
 bool SocketClient::closeSocket() {
 
-    Logger::log("Closing Socket.\n");
+    LOG_INFO(Net, "Closing Socket.\n");
 
     bool result = false;
 
     if (!(result = SocketBase::closeSocket())) {
-        Logger::log("Failed to close socket!\n");
+        LOG_ERROR(Net, "Failed to close socket!\n");
     }
 
     return result;
@@ -289,16 +302,16 @@ bool SocketClient::stringToIPAddress(const char* str, in_addr* out) {
  */
 bool SocketClient::startThreads() {
 
-    Logger::log("Recv Thread isDone: %s\n", BTOC(this->mRecvThread->isDone()));
-    Logger::log("Send Thread isDone: %s\n", BTOC(this->mSendThread->isDone()));
+    LOG_DEBUG(Net, "Recv Thread isDone: %s\n", BTOC(this->mRecvThread->isDone()));
+    LOG_DEBUG(Net, "Send Thread isDone: %s\n", BTOC(this->mSendThread->isDone()));
 
     if(this->mRecvThread->isDone() && this->mSendThread->isDone()) {
         this->mRecvThread->start();
         this->mSendThread->start();
-        Logger::log("Socket threads sucessfully started.\n");
+        LOG_INFO(Net, "Socket threads sucessfully started.\n");
         return true;
     }else {
-        Logger::log("Socket threads failed to start.\n");
+        LOG_ERROR(Net, "Socket threads failed to start.\n");
         return false;
     }
 }
@@ -310,28 +323,30 @@ void SocketClient::endThreads() {
 
 void SocketClient::sendFunc() {
 
-    Logger::log("Starting Send Thread.\n");
+    LOG_INFO(Net, "Starting Send Thread.\n");
 
     while (true) {
+        ThreadConfig::updateCurrentThread(NetThread::SocketSend);
         trySendQueue();
     }
 
-    Logger::log("Ending Send Thread.\n");
+    LOG_INFO(Net, "Ending Send Thread.\n");
 }
 
 void SocketClient::recvFunc() {
 
     nn::socket::Recv(this->socket_log_socket, nullptr, 0, 0);
 
-    Logger::log("Starting Recv Thread.\n");
+    LOG_INFO(Net, "Starting Recv Thread.\n");
 
     while (true) {
+        ThreadConfig::updateCurrentThread(NetThread::SocketRecv);
         if (!recv()) {
-            Logger::log("Receiving Packet Failed!\n");
+            LOG_ERROR(Net, "Receiving Packet Failed!\n");
         }
     }
 
-    Logger::log("Ending Recv Thread.\n");
+    LOG_INFO(Net, "Ending Recv Thread.\n");
 }
 
 bool SocketClient::queuePacket(Packet* packet) {
@@ -341,8 +356,12 @@ bool SocketClient::queuePacket(Packet* packet) {
                 (s64)packet,
                 sead::MessageQueue::BlockType::NonBlocking);  // as this is non-blocking, it
                                                               // will always return true.
+            NetStats::recordQueueCount(NetQueue::Send, mSendQueue.getCount());
             return true;
         }
+        NetStats::recordDrop(packet->mType, NetDropReason::SendQueueFull);
+    } else {
+        NetStats::recordDrop(packet->mType, NetDropReason::NotConnected);
     }
     mHeap->free(packet);
     return false;
@@ -0,0 +1,163 @@
+#include "server/ThreadConfig.hpp"
+#include <cstdio>
+#include "logger.hpp"
+#include "nn/os.h"
+#include "nx/svc.h"
+
+static constexpr u32 cInfoThreadTickCount = 0xF0000002;
+static constexpr u32 cCurrentThreadHandle = 0xFFFF8000;
+
+static constexpr s32 sPriorityPresets[ThreadConfig::cPriorityPresetCount] = {ThreadConfig::cDefaultPriority, 10, 16, 24};
+static constexpr u64 sCoreMaskPresets[ThreadConfig::cCoreMaskPresetCount] = {0, 0b001, 0b010, 0b100, 0b111};
+
+ThreadSettings ThreadConfig::sSettings[(int)NetThread::End] = {
+    {cDefaultPriority, 0, 0x1000},  // SocketRecvThread
+    {cDefaultPriority, 0, 0x1000},  // SocketSendThread
+    {cDefaultPriority, 0, 0x1000},  // ClientReadThread
+    {cDefaultPriority, 0, 0x4000},  // LogFlushThread, stack is static in logger.cpp
+};
+
+ThreadState ThreadConfig::sStates[(int)NetThread::End];
+std::atomic<u32> ThreadConfig::sGeneration = 0;
+bool ThreadConfig::sIsMeasureCpuTime = false;
+
+al::AsyncFunctorThread* ThreadConfig::createThread(NetThread thread, const al::FunctorBase& functor) {
+    return new al::AsyncFunctorThread(getName(thread), functor, 0, getSettings(thread).stackSize, {0});
+}
+
+void ThreadConfig::updateCurrentThread(NetThread thread) {
+    ThreadState& state = sStates[(int)thread];
+    nn::os::ThreadType* curThread = nn::os::GetCurrentThread();
+
+    if (!state.isDefaultsSaved) {
+        state.defaultPriority = nn::os::GetThreadPriority(curThread);
+        nn::os::GetThreadCoreMask(&state.defaultIdealCore, &state.defaultCoreMask, curThread);
+        state.isDefaultsSaved = true;
+    }
+
+    u32 generation = sGeneration.load(std::memory_order_acquire);
+
+    if (state.appliedGeneration != generation) {
+        const ThreadSettings& settings = sSettings[(int)thread];
+
+        nn::os::ChangeThreadPriority(curThread, settings.priority == cDefaultPriority ? state.defaultPriority : settings.priority);
+
+        if (settings.coreMask) {
+            nn::os::SetThreadCoreMask(curThread, __builtin_ctzll(settings.coreMask), settings.coreMask);
+        } else {
+            nn::os::SetThreadCoreMask(curThread, state.defaultIdealCore, state.defaultCoreMask);
+        }
+
+        state.appliedGeneration = generation;
+
+        LOG_DEBUG(Net, "Applied Thread Config to %s.\n", getName(thread));
+    }
+
+    if (!sIsMeasureCpuTime) {
+        state.lastSampleTick = 0;
+        return;
+    }
+
+    u64 now = nn::os::GetSystemTick();
+
+    // sample once a second, the syscall is cheap but there's no reason to do it every loop
+    if (state.lastSampleTick && now - state.lastSampleTick < nn::os::GetSystemTickFrequency()) {
+        return;
+    }
+
+    u64 cpuTicks = 0;
+
+    if (svcGetInfo(&cpuTicks, cInfoThreadTickCount, cCurrentThreadHandle, (u64)-1) == 0) {
+        if (state.lastSampleTick) {
+            u64 usedTicks = cpuTicks - state.lastCpuTicks;
+            state.totalCpuTicks += usedTicks;
+            state.cpuUsage = (float)usedTicks * 100.f / (float)(now - state.lastSampleTick);
+        }
+        state.lastCpuTicks = cpuTicks;
+    }
+
+    state.lastSampleTick = now;
+}
+
+const char* ThreadConfig::getName(NetThread thread) {
+    switch (thread) {
+    case NetThread::SocketRecv:
+        return "SocketRecvThread";
+    case NetThread::SocketSend:
+        return "SocketSendThread";
+    case NetThread::ClientRead:
+        return "ClientReadThread";
+    case NetThread::LogFlush:
+        return "LogFlushThread";
+    default:
+        return "Unknown";
+    }
+}
+
+void ThreadConfig::setPriority(NetThread thread, s32 priority) {
+    sSettings[(int)thread].priority = priority;
+    sGeneration.fetch_add(1, std::memory_order_release);
+}
+
+void ThreadConfig::setCoreMask(NetThread thread, u64 coreMask) {
+    sSettings[(int)thread].coreMask = coreMask;
+    sGeneration.fetch_add(1, std::memory_order_release);
+}
+
+void ThreadConfig::cyclePriority(NetThread thread) {
+    s32 curPriority = getSettings(thread).priority;
+
+    for (int i = 0; i < cPriorityPresetCount; i++) {
+        if (sPriorityPresets[i] == curPriority) {
+            setPriority(thread, sPriorityPresets[(i + 1) % cPriorityPresetCount]);
+            return;
+        }
+    }
+
+    setPriority(thread, sPriorityPresets[0]);
+}
+
+void ThreadConfig::cycleCoreMask(NetThread thread) {
+    u64 curMask = getSettings(thread).coreMask;
+
+    for (int i = 0; i < cCoreMaskPresetCount; i++) {
+        if (sCoreMaskPresets[i] == curMask) {
+            setCoreMask(thread, sCoreMaskPresets[(i + 1) % cCoreMaskPresetCount]);
+            return;
+        }
+    }
+
+    setCoreMask(thread, sCoreMaskPresets[0]);
+}
+
+void ThreadConfig::getPriorityString(char* out, size_t size, s32 priority) {
+    if (priority == cDefaultPriority) {
+        snprintf(out, size, "Default");
+    } else {
+        snprintf(out, size, "%d", priority);
+    }
+}
+
+void ThreadConfig::getCoreMaskString(char* out, size_t size, u64 coreMask) {
+    if (!coreMask) {
+        snprintf(out, size, "Default");
+        return;
+    }
+
+    int len = snprintf(out, size, "Core");
+
+    for (int core = 0; core < 4 && len < (int)size; core++) {
+        if (coreMask & (1ull << core)) {
+            len += snprintf(out + len, size - len, " %d", core);
+        }
+    }
+}
+
+void ThreadConfig::setMeasureCpuTime(bool value) {
+    sIsMeasureCpuTime = value;
+    LOG_DEBUG(Net, "Thread CPU Time Measurement: %s\n", BTOC(value));
+}
+
+float ThreadConfig::getCpuTimeMs(NetThread thread) {
+    return (float)((double)getState(thread).totalCpuTicks * 1000.0 / (double)nn::os::GetSystemTickFrequency());
+}
@@ -6,6 +6,7 @@
 #include "main.hpp"
 #include "actors/PuppetHackActor.h"
 #include "al/actor/alPlacementFunction.h"
+#include "puppets/CaptureActorPool.hpp"
 
 
 // Helper Methods
@@ -14,32 +15,16 @@ bool isInCaptureList(const char* capture) {
     return CaptureTypes::FindType(capture) != CaptureTypes::Type::Unknown;
 }
 
-PuppetHackActor *createPuppetHackActorFromFactory(al::ActorInitInfo const &rootInitInfo, const al::PlacementInfo *rootPlacementInfo, PuppetInfo *curInfo, const char *hackType) {
+PuppetHackActor *createPuppetHackActorFromFactory(al::ActorInitInfo const &rootInitInfo, const al::PlacementInfo *rootPlacementInfo, const char *hackType) {
     al::ActorInitInfo actorInitInfo = al::ActorInitInfo();
     actorInitInfo.initViewIdSelf(rootPlacementInfo, rootInitInfo);
 
-    int serverMaxPlayers = Client::getMaxPlayerCount(); // TODO: Find a way around needing to do this, such as creating a single hack actor per puppet that can dynamically switch models
-
-    // only use this if player count is 8
-    if (serverMaxPlayers == 8) {
-        const char *stageName = "";
-        if (actorInitInfo.mPlacementInfo._0.tryGetStringByKey(&stageName, "PlacementFileName")) {
-            if (al::isEqualString(stageName, "ForestWorldHomeStage")) {
-                return nullptr;
-            }
-        }
-    }
-
-    if (serverMaxPlayers > 8) { // disable capture sync if dealing with more than 8 players
-        return nullptr;
-    }
-
     al::createActor createActor = actorInitInfo.mActorFactory->getCreator("PuppetHackActor");
     
     if(createActor) {
         PuppetHackActor *newActor = (PuppetHackActor*)createActor("PuppetHackActor");
 
-        newActor->initOnline(curInfo, hackType); // set puppet info first before calling init so we can get costume info from the info
+        newActor->initOnline(nullptr, hackType); // puppet info is set when the actor is leased from the pool
 
         newActor->init(actorInitInfo);
 
@@ -61,38 +46,22 @@ al::LiveActor *initObjHook(al::ActorInitInfo const &initInfo, al::PlacementInfo
 
     if(isInCaptureList(className)) 
     {
+        const char* hackName = tryConvertName(className);
 
-        int serverMaxPlayers = Client::getMaxPlayerCount();
-
-        for (size_t i = 0; i < serverMaxPlayers - 1; i++)
-        {
-            PuppetActor* curPuppet = Client::getPuppet(i);
-            if (curPuppet) {
+        int puppetCount = Client::getMaxPlayerCount() - 1;
 
-                const char* hackName = tryConvertName(className);
-
-                // make sure we only make as many unique puppet hack actors as needed
-                if(!curPuppet->isInCaptureList(hackName)) {
-
-                    PuppetHackActor* dupliActor = createPuppetHackActorFromFactory(
-                        initInfo, placement, curPuppet->getInfo(), hackName);
-                    if (dupliActor) {
-                        curPuppet->addCapture(dupliActor, hackName);
-                    }
-                }
-            }
+        if (Client::getDebugPuppet()) {
+            puppetCount++;
         }
 
-        PuppetActor* debugPuppet = Client::getDebugPuppet();
+        // make sure we only make as many pooled hack actors as puppets that could be in this capture at once
+        int typeSize = CaptureActorPool::calcTypeSize(puppetCount);
 
-        if (debugPuppet) {
-            const char* hackName = tryConvertName(className);
-            if(!debugPuppet->isInCaptureList(hackName)) {
+        for (int i = CaptureActorPool::getTypeCount(hackName); i < typeSize; i++) {
+            PuppetHackActor* dupliActor = createPuppetHackActorFromFactory(initInfo, placement, hackName);
 
-                PuppetHackActor *dupliActor = createPuppetHackActorFromFactory(initInfo, placement, debugPuppet->getInfo(), hackName);
-                if (dupliActor) {
-                    debugPuppet->addCapture(dupliActor, hackName);
-                }
+            if (!dupliActor || !CaptureActorPool::addActor(dupliActor, hackName)) {
+                break;
             }
         }
     }
@@ -34,10 +34,10 @@ bool FreezeTagConfigMenu::updateMenu(int selectIndex) {
 
     FreezeTagInfo *curMode = GameModeManager::instance()->getInfo<FreezeTagInfo>();
 
-    Logger::log("Updating freeze tag menu\n");
+    LOG_TRACE(Menu, "Updating freeze tag menu\n");
 
     if (!curMode) {
-        Logger::log("Unable to Load Mode info!\n");
+        LOG_ERROR(Menu, "Unable to Load Mode info!\n");
         return true;   
     }
     
@@ -113,7 +113,7 @@ bool FreezeTagConfigMenu::updateMenu(int selectIndex) {
             return true;
         }
         default:
-            Logger::log("Failed to interpret Index!\n");
+            LOG_ERROR(Menu, "Failed to interpret Index!\n");
             return false;
     }
     
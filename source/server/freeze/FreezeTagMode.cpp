@@ -26,6 +26,7 @@
 #include "server/freeze/FreezeTagScore.hpp"
 #include "server/gamemode/GameModeBase.hpp"
 #include "server/Client.hpp"
+#include "server/PuppetQuery.hpp"
 #include "server/gamemode/GameModeTimer.hpp"
 #include <heap/seadHeap.h>
 #include "server/gamemode/GameModeManager.hpp"
@@ -45,8 +46,8 @@ void FreezeTagMode::init(const GameModeInitInfo& info) {
 
     GameModeInfoBase* curGameInfo = GameModeManager::instance()->getInfo<FreezeTagInfo>();
 
-    if (curGameInfo) Logger::log("Gamemode info found: %s %s\n", GameModeFactory::getModeString(curGameInfo->mMode), GameModeFactory::getModeString(info.mMode));
-    else Logger::log("No gamemode info found\n");
+    if (curGameInfo) LOG_INFO(GameMode, "Gamemode info found: %s %s\n", GameModeFactory::getModeString(curGameInfo->mMode), GameModeFactory::getModeString(info.mMode));
+    else LOG_WARN(GameMode, "No gamemode info found\n");
     if (curGameInfo && curGameInfo->mMode == mMode) {
         mInfo = (FreezeTagInfo*)curGameInfo;
         mModeTimer = new GameModeTimer(mInfo->mRoundTimer);
@@ -59,12 +60,12 @@ void FreezeTagMode::init(const GameModeInitInfo& info) {
     mInfo->mRunnerPlayers.allocBuffer(0x10, al::getSceneHeap());
     mInfo->mChaserPlayers.allocBuffer(0x10, al::getSceneHeap());
 
-    Logger::log("Scene Heap Free Size: %f/%f\n", al::getSceneHeap()->getFreeSize() * 0.001f, al::getSceneHeap()->getSize() * 0.001f);
+    LOG_DEBUG(GameMode, "Scene Heap Free Size: %f/%f\n", al::getSceneHeap()->getFreeSize() * 0.001f, al::getSceneHeap()->getSize() * 0.001f);
 
     mModeLayout = new FreezeTagIcon("FreezeTagIcon", *info.mLayoutInitInfo);
     mInfo->mPlayerTagScore.setTargetLayout(mModeLayout);
     
-    Logger::log("Scene Heap Free Size: %f/%f\n", al::getSceneHeap()->getFreeSize() * 0.001f, al::getSceneHeap()->getSize() * 0.001f);
+    LOG_DEBUG(GameMode, "Scene Heap Free Size: %f/%f\n", al::getSceneHeap()->getFreeSize() * 0.001f, al::getSceneHeap()->getSize() * 0.001f);
 
     // Create main player's ice block
     mMainPlayerIceBlock = new FreezePlayerBlock("MainPlayerBlock");
@@ -242,13 +243,13 @@ void FreezeTagMode::update() {
     if (mInfo->mIsRound) {
         if (mInvulnTime >= 3) {
             bool isPDead = PlayerFunction::isPlayerDeadStatus(player);
-            bool isP2D = ((PlayerActorHakoniwa*)player)->mDimKeeper->is2D;
 
             for (size_t i = 0; i < mPuppetHolder->getSize(); i++) {
                 PuppetInfo *curInfo = Client::getPuppetInfo(i);
-                float pupDist = al::calcDistance(player, curInfo->playerPos);
+                const PuppetQueryResult& query = PuppetQuery::get(i);
+                float pupDist = query.dist;
 
-                if(!curInfo->isConnected || !curInfo->isInSameStage)
+                if(!query.isActive)
                     continue;
                 
                 // If this puppet is the new closest, set the closest info to the current puppet
@@ -261,12 +262,12 @@ void FreezeTagMode::update() {
                     continue;
 
                 //Check for freeze
-                if (!mInfo->mIsPlayerFreeze && pupDist < 250.f && isP2D == curInfo->is2D && !isPDead && !curInfo->isFreezeTagRunner)
+                if (!mInfo->mIsPlayerFreeze && pupDist < 250.f && query.isSame2D && !isPDead && !curInfo->isFreezeTagRunner)
                     trySetPlayerRunnerState(FreezeState::FREEZE);
 
                 //Check for unfreeze
                 float freezeMinTime = al::clamp(3.f + (mInfo->mFreezeCount * 0.5f), 3.f, 7.f);
-                if (mInvulnTime >= freezeMinTime && mInfo->mIsPlayerFreeze && pupDist < 200.f && isP2D == curInfo->is2D
+                if (mInvulnTime >= freezeMinTime && mInfo->mIsPlayerFreeze && pupDist < 200.f && query.isSame2D
                 && !isPDead && curInfo->isFreezeTagRunner && !curInfo->isFreezeTagFreeze) {
                     trySetPlayerRunnerState(FreezeState::ALIVE);
                 }
@@ -155,7 +155,7 @@ bool FreezeTagMode::tryStartRecoveryEvent(bool isEndgame)
         mRecoverySafetyPoint = sead::Vector3f::zero;
     }
     
-    Logger::log("Recovery event %.00fx %.00fy %.00fz\n", mRecoverySafetyPoint.x, mRecoverySafetyPoint.y, mRecoverySafetyPoint.z);
+    LOG_TRACE(GameMode, "Recovery event %.00fx %.00fy %.00fz\n", mRecoverySafetyPoint.x, mRecoverySafetyPoint.y, mRecoverySafetyPoint.z);
 
     return true;
 }
@@ -276,7 +276,7 @@ bool FreezeTagMode::trySetPostProcessingType(FreezePostProcessingType type)
 
     al::validatePostProcessingFilter(mCurScene);
 
-    Logger::log("Set post processing to %i\n", al::getPostProcessingFilterPresetId(mCurScene));
+    LOG_DEBUG(GameMode, "Set post processing to %i\n", al::getPostProcessingFilterPresetId(mCurScene));
 
     return true; // Set post processing mode to on at desired index
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <heap/seadHeapMgr.h>
 #include "al/util.hpp"
 #include "logger.hpp"
+#include "server/FrameProfiler.hpp"
 #include "server/gamemode/GameModeBase.hpp"
 #include "server/gamemode/GameModeFactory.hpp"
 #include "server/gamemode/modifiers/ModeModifierBase.hpp"
@@ -23,7 +24,7 @@ void GameModeManager::begin() {
     if (mCurModeBase) {
         sead::ScopedCurrentHeapSetter heapSetter(mHeap);
         mCurModeBase->begin();
-        Logger::log("Beginning Mode.\n");
+        LOG_INFO(GameMode, "Beginning Mode.\n");
     }
 }
 
@@ -31,7 +32,7 @@ void GameModeManager::end() {
     if (mCurModeBase) {
         sead::ScopedCurrentHeapSetter heapSetter(mHeap);
         mCurModeBase->end();
-        Logger::log("Ending Mode.\n");
+        LOG_INFO(GameMode, "Ending Mode.\n");
     }
 }
 
@@ -39,7 +40,7 @@ void GameModeManager::pause() {
     if (mCurModeBase) {
         sead::ScopedCurrentHeapSetter heapSetter(mHeap);
         mCurModeBase->pause();
-        Logger::log("Pausing Mode.\n");
+        LOG_INFO(GameMode, "Pausing Mode.\n");
     }
 }
 
@@ -47,7 +48,7 @@ void GameModeManager::unpause() {
     if (mCurModeBase) {
         sead::ScopedCurrentHeapSetter heapSetter(mHeap);
         mCurModeBase->unpause();
-        Logger::log("Unpausing Mode.\n");
+        LOG_INFO(GameMode, "Unpausing Mode.\n");
     }
 }
 
@@ -66,6 +67,8 @@ void GameModeManager::setMode(GameMode mode) {
 }
 
 void GameModeManager::update() {
+    PROFILE_SCOPE(ProfileZone::GameModeUpdate);
+
     if (!mCurModeBase) return;
     bool inScene = al::getSceneHeap() != nullptr;
     if ((mActive && inScene && !mCurModeBase->isModeActive() && !mPaused && !mWasPaused) || mWasSceneTrans) {
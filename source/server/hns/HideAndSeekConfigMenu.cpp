@@ -32,10 +32,10 @@ bool HideAndSeekConfigMenu::updateMenu(int selectIndex) {
 
     HideAndSeekInfo *curMode = GameModeManager::instance()->getInfo<HideAndSeekInfo>();
 
-    Logger::log("Setting Gravity Mode.\n");
+    LOG_INFO(Menu, "Setting Gravity Mode.\n");
 
     if (!curMode) {
-        Logger::log("Unable to Load Mode info!\n");
+        LOG_ERROR(Menu, "Unable to Load Mode info!\n");
         return true;   
     }
     
@@ -47,7 +47,7 @@ bool HideAndSeekConfigMenu::updateMenu(int selectIndex) {
             return true;
         }
         default:
-            Logger::log("Failed to interpret Index!\n");
+            LOG_ERROR(Menu, "Failed to interpret Index!\n");
             return false;
     }
     
@@ -18,6 +18,7 @@
 #include "rs/util/PlayerUtil.h"
 #include "server/gamemode/GameModeBase.hpp"
 #include "server/Client.hpp"
+#include "server/PuppetQuery.hpp"
 #include "server/gamemode/GameModeTimer.hpp"
 #include <heap/seadHeap.h>
 #include <math.h>
@@ -37,12 +38,12 @@ void HideAndSeekMode::init(const GameModeInitInfo& info) {
 
     GameModeInfoBase* curGameInfo = GameModeManager::instance()->getInfo<HideAndSeekInfo>();
 
-    if (curGameInfo) Logger::log("Gamemode info found: %s %s\n", GameModeFactory::getModeString(curGameInfo->mMode), GameModeFactory::getModeString(info.mMode));
-    else Logger::log("No gamemode info found\n");
+    if (curGameInfo) LOG_INFO(GameMode, "Gamemode info found: %s %s\n", GameModeFactory::getModeString(curGameInfo->mMode), GameModeFactory::getModeString(info.mMode));
+    else LOG_WARN(GameMode, "No gamemode info found\n");
     if (curGameInfo && curGameInfo->mMode == mMode) {
         mInfo = (HideAndSeekInfo*)curGameInfo;
         mModeTimer = new GameModeTimer(mInfo->mHidingTime);
-        Logger::log("Reinitialized timer with time %d:%.2d\n", mInfo->mHidingTime.mMinutes, mInfo->mHidingTime.mSeconds);
+        LOG_INFO(GameMode, "Reinitialized timer with time %d:%.2d\n", mInfo->mHidingTime.mMinutes, mInfo->mHidingTime.mSeconds);
     } else {
         if (curGameInfo) delete curGameInfo;  // attempt to destory previous info before creating new one
         
@@ -175,18 +176,16 @@ void HideAndSeekMode::update() {
                     PuppetInfo *curInfo = Client::getPuppetInfo(i);
 
                     if (!curInfo) {
-                        Logger::log("Checking %d, hit bounds %d-%d\n", i, mPuppetHolder->getSize(), Client::getMaxPlayerCount());
+                        LOG_TRACE(GameMode, "Checking %d, hit bounds %d-%d\n", i, mPuppetHolder->getSize(), Client::getMaxPlayerCount());
                         break;
                     }
 
-                    if(curInfo->isConnected && curInfo->isInSameStage && curInfo->isIt) {
+                    const PuppetQueryResult& query = PuppetQuery::get(i);
 
-                        sead::Vector3f offset = sead::Vector3f(0.0f, 80.0f, 0.0f);
-            
-                        float pupDist = vecDistance(curInfo->playerPos + offset, al::getTrans(playerBase) + offset); // TODO: remove distance calculations and use hit sensors to determine this
+                    if(query.isActive && curInfo->isIt) {
 
                         if (!isYukimaru) {
-                            if(pupDist < 200.f && ((PlayerActorHakoniwa*)playerBase)->mDimKeeper->is2DModel == curInfo->is2D) {
+                            if(query.dist < 200.f && query.isSame2D) { // TODO: remove distance calculations and use hit sensors to determine this
                                 if(!PlayerFunction::isPlayerDeadStatus(playerBase)) {
                                     
                                     GameDataFunction::killPlayer(GameDataHolderAccessor(this));
@@ -2,14 +2,108 @@
 #include "al/util/ControllerUtil.h"
 #include "helpers.hpp"
 #include "nn/result.h"
+#include "nn/os.h"
+#include "nn/fs.h"
+#include "server/ThreadConfig.hpp"
+
+#include <atomic>
 
 // If connection fails, try X ports above the specified one
 // Useful for debugging multple clients on the same machine
 constexpr u32 ADDITIONAL_LOG_PORT_COUNT = 2;
 
 Logger* Logger::sInstance = nullptr;
+LogLevel Logger::sMinLevel = LOG_COMPILED_LEVEL > (int)LogLevel::Debug ? (LogLevel)LOG_COMPILED_LEVEL : LogLevel::Debug;
+u32 Logger::sCategoryMask = LOG_COMPILED_CATEGORIES;
+
+// log calls format on the calling thread and push the message into this ring, the flush thread then batches everything
+// onto the socket. each record is a u32 length header followed by the message, padded to 4 bytes so headers never wrap.
+// a header of 0 means the record is reserved but not written yet, so consumed records are zeroed before being released.
+static constexpr u32 cLogRingSize = 0x8000;
+static constexpr u32 cLogFlushBufSize = 0x1000;
+static constexpr u32 cLogFlushStackSize = 0x4000;
+static constexpr s32 cLogFlushPriority = 28; // nn::os priority, 31 is the lowest. only the default, ThreadConfig can override it
+static constexpr u64 cLogFlushIntervalNs = 16000000; // roughly once a frame
+
+alignas(4) static char sLogRing[cLogRingSize] = {};
+static std::atomic<u64> sLogWritePos = 0;
+static std::atomic<u64> sLogReadPos = 0;
+static std::atomic<u32> sLogDropCount = 0;
+static u32 sLogReportedDrops = 0;
+
+static char sLogFlushBuf[cLogFlushBufSize];
+alignas(0x1000) static u8 sLogFlushStack[cLogFlushStackSize];
+static nn::os::ThreadType sLogFlushThread;
+static bool sIsLogFlushStarted = false;
+
+// without a connected log server the flush thread appends to a log file on the SD card instead. output is collected in
+// sLogFileBuf so the card only sees a few large writes. the previous session is kept in cLogFilePrevPath, and the
+// current file is rotated there once it reaches cLogFileMaxSize.
+static constexpr const char* cLogFileMount = "sd";
+static constexpr const char* cLogFileDir = "sd:/SMOO";
+static constexpr const char* cLogFilePath = "sd:/SMOO/latest.log";
+static constexpr const char* cLogFilePrevPath = "sd:/SMOO/previous.log";
+static constexpr u32 cLogFileBufSize = 0x10000;
+static constexpr s64 cLogFileMaxSize = 0x100000;
+static constexpr u64 cLogFileFlushIntervalSec = 5;
+
+static char sLogFileBuf[cLogFileBufSize];
+static u32 sLogFileBufLen = 0;
+static nn::fs::FileHandle sLogFile;
+static s64 sLogFileOffset = 0;
+static bool sIsLogFileOpen = false;
+static bool sIsLogFileFailed = false;
+static u64 sLogFileLastFlushTick = 0;
+static std::atomic<bool> sIsLogFileFlushRequested = false;
+
+static u32 calcRecordSize(u32 len) {
+    return (sizeof(u32) + len + 3) & ~3;
+}
+
+static void copyToRing(u64 pos, const char* src, u32 len) {
+    u32 offset = pos % cLogRingSize;
+    u32 first = len < cLogRingSize - offset ? len : cLogRingSize - offset;
+    memcpy(sLogRing + offset, src, first);
+    memcpy(sLogRing, src + first, len - first);
+}
+
+static void copyFromRing(char* dst, u64 pos, u32 len) {
+    u32 offset = pos % cLogRingSize;
+    u32 first = len < cLogRingSize - offset ? len : cLogRingSize - offset;
+    memcpy(dst, sLogRing + offset, first);
+    memcpy(dst + first, sLogRing, len - first);
+}
+
+static u8 makeLevelCategory(LogLevel level, LogCategory category) {
+    return ((u8)level << 4) | ((u8)category & 0xF);
+}
+
+// writes a binary record header followed by the payload into out, returns the record size
+static u32 makeRecord(char* out, LogRecordType type, u8 levelCategory, u32 fmtHash, const void* payload, u32 len) {
+    LogRecordHeader header;
+    header.size = len;
+    header.type = type;
+    header.levelCategory = levelCategory;
+    header.fmtHash = fmtHash;
+    header.tick = nn::os::GetSystemTick();
+
+    memcpy(out, &header, sizeof(header));
+    memcpy(out + sizeof(header), payload, len);
+    return sizeof(header) + len;
+}
+
+static void clearRing(u64 pos, u32 len) {
+    u32 offset = pos % cLogRingSize;
+    u32 first = len < cLogRingSize - offset ? len : cLogRingSize - offset;
+    memset(sLogRing + offset, 0, first);
+    memset(sLogRing, 0, len - first);
+}
 
 void Logger::createInstance() {
+    #if !DEBUGLOG && !LOG_SD_CARD
+    return;  // release build without the SD card log, there's nowhere to send anything
+    #endif
+
     #ifdef SERVERIP
     sInstance = new Logger(TOSTRING(SERVERIP), 3080, "MainLogger");
     #else
@@ -17,6 +111,15 @@ void Logger::createInstance() {
     #endif
 }
 
+// start of every binary stream, see cLogBinaryMagic
+u32 Logger::makeHandshake(char* out) {
+    u64 tickFrequency = nn::os::GetSystemTickFrequency();
+    memcpy(out, cLogBinaryMagic, sizeof(cLogBinaryMagic));
+    memcpy(out + sizeof(cLogBinaryMagic), &tickFrequency, sizeof(tickFrequency));
+    u32 size = sizeof(cLogBinaryMagic) + sizeof(u64);
+    return size + makeRecord(out + size, LogRecordType::Name, 0, 0, sockName, strnlen(sockName, sizeof(sockName)));
+}
+
 nn::Result Logger::init(const char* ip, u16 port) {
 
     sock_ip = ip;
@@ -73,6 +176,13 @@ nn::Result Logger::init(const char* ip, u16 port) {
     if (connected) {
         this->socket_log_state = SOCKET_LOG_CONNECTED;
         this->isDisableName = false;
+
+        #if LOG_BINARY
+        // sent before the flush thread starts so it's always the first thing in the stream
+        char handshake[sizeof(cLogBinaryMagic) + sizeof(u64) + sizeof(LogRecordHeader) + sizeof(sockName)];
+        nn::socket::Send(this->socket_log_socket, handshake, makeHandshake(handshake), 0);
+        #endif
+
         return 0;
     } else {
         this->socket_log_state = SOCKET_LOG_UNAVAILABLE;
@@ -80,12 +190,13 @@ nn::Result Logger::init(const char* ip, u16 port) {
     }
 }
 
-void Logger::log(const char *fmt, va_list args) { // impl for replacing seads system::print
-    if (!sInstance)
+void Logger::log(LogLevel level, LogCategory category, const char *fmt, va_list args) { // impl for replacing seads system::print
+    if (!isEnabled(level, category))
         return;
     char buf[0x500];
-    if (nn::util::VSNPrintf(buf, sizeof(buf), fmt, args) > 0) {
-        sInstance->socket_log(buf);
+    int len = nn::util::VSNPrintf(buf, sizeof(buf), fmt, args);
+    if (len > 0) {
+        pushText(level, category, buf, len < (int)sizeof(buf) ? len : sizeof(buf) - 1); // VSNPrintf returns the untruncated length
     }
 }
 
@@ -100,18 +211,287 @@ void Logger::log(const char* fmt, ...) {
     va_start(args, fmt);
 
     char buf[0x500];
+    int len = 0;
+
+    // the binary decoder prefixes the name itself
+    if (!LOG_BINARY && !sInstance->isDisableName) {
+        len = nn::util::SNPrintf(buf, sizeof(buf), "[%s] ", sInstance->sockName);
+    }
+
+    int msgLen = nn::util::VSNPrintf(buf + len, sizeof(buf) - len, fmt, args);
+
+    if (msgLen > 0) {
+        pushText(LogLevel::Info, LogCategory::General, buf, len + msgLen < (int)sizeof(buf) ? len + msgLen : sizeof(buf) - 1);
+    }
+
+    va_end(args);
+}
+
+void Logger::cycleMinLevel() {
+    int level = (int)sMinLevel + 1;
+
+    if (level >= (int)LogLevel::End || level < LOG_COMPILED_LEVEL) {
+        level = LOG_COMPILED_LEVEL;
+    }
+
+    sMinLevel = (LogLevel)level;
+}
+
+void Logger::setCategoryEnabled(LogCategory category, bool isEnable) {
+    if (isEnable) {
+        sCategoryMask |= 1u << (int)category;
+    } else {
+        sCategoryMask &= ~(1u << (int)category);
+    }
+}
+
+const char* Logger::getLevelName(LogLevel level) {
+    switch (level) {
+    case LogLevel::Trace:
+        return "Trace";
+    case LogLevel::Debug:
+        return "Debug";
+    case LogLevel::Info:
+        return "Info";
+    case LogLevel::Warn:
+        return "Warn";
+    case LogLevel::Error:
+        return "Error";
+    default:
+        return "Unknown";
+    }
+}
+
+const char* Logger::getCategoryName(LogCategory category) {
+    switch (category) {
+    case LogCategory::General:
+        return "General";
+    case LogCategory::Net:
+        return "Net";
+    case LogCategory::Puppet:
+        return "Puppet";
+    case LogCategory::GameMode:
+        return "GameMode";
+    case LogCategory::Boot:
+        return "Boot";
+    case LogCategory::Menu:
+        return "Menu";
+    default:
+        return "Unknown";
+    }
+}
+
+void Logger::setLogName(const char* name) {
+    if (!sInstance)
+        return;
+
+    sInstance->setName(name);
+
+    if (LOG_BINARY) {
+        pushName(sInstance->sockName);
+    }
+}
+
+void Logger::requestFileFlush() {
+    sIsLogFileFlushRequested.store(true, std::memory_order_relaxed);
+}
+
+const char* Logger::getOutputName() {
+    if (!sInstance)
+        return "None";
+    if (sInstance->socket_log_state == SOCKET_LOG_CONNECTED)
+        return "Server";
+    if (!LOG_SD_CARD)
+        return "None";
+    return sIsLogFileFailed ? "None (SD Card Failed)" : "SD Card";
+}
+
+u32 Logger::getDropCount() {
+    return sLogDropCount.load(std::memory_order_relaxed);
+}
+
+// reserves space in the ring without ever waiting, if the flush thread can't keep up the message is dropped and counted
+void Logger::push(const char* str, int len) {
+    u32 recordSize = calcRecordSize(len);
+    u64 pos = sLogWritePos.load(std::memory_order_relaxed);
+
+    do {
+        if (pos + recordSize - sLogReadPos.load(std::memory_order_acquire) > cLogRingSize) {
+            sLogDropCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    } while (!sLogWritePos.compare_exchange_weak(pos, pos + recordSize, std::memory_order_relaxed));
+
+    copyToRing(pos + sizeof(u32), str, len);
 
-    if (nn::util::VSNPrintf(buf, sizeof(buf), fmt, args) > 0) {
-        if (!sInstance->isDisableName) {
-            char prefix[0x510];
-            nn::util::SNPrintf(prefix, sizeof(prefix), "[%s] %s", sInstance->sockName, buf);
-            sInstance->socket_log(prefix);
+    __atomic_store_n((u32*)(sLogRing + pos % cLogRingSize), (u32)len, __ATOMIC_RELEASE);
+}
+
+void Logger::pushText(LogLevel level, LogCategory category, const char* str, int len) {
+    if (!LOG_BINARY) {
+        push(str, len);
+        return;
+    }
+
+    char record[sizeof(LogRecordHeader) + 0x500];
+    len = len < 0x500 ? len : 0x500;
+    push(record, makeRecord(record, LogRecordType::Text, makeLevelCategory(level, category), 0, str, len));
+}
+
+void Logger::pushFormat(LogLevel level, LogCategory category, u32 fmtHash, const LogArgWriter& args) {
+    char record[sizeof(LogRecordHeader) + LogArgWriter::cMaxSize];
+    push(record, makeRecord(record, LogRecordType::Format, makeLevelCategory(level, category), fmtHash, args.getData(), args.getSize()));
+}
+
+void Logger::pushName(const char* name) {
+    char record[sizeof(LogRecordHeader) + sizeof(sockName)];
+    push(record, makeRecord(record, LogRecordType::Name, 0, 0, name, strnlen(name, sizeof(sockName))));
+}
+
+void Logger::startFlushThread() {
+    if (sIsLogFlushStarted)
+        return;
+
+    if (nn::os::CreateThread(&sLogFlushThread, &Logger::flushThreadFunc, this, sLogFlushStack, sizeof(sLogFlushStack), cLogFlushPriority).isFailure())
+        return;
+
+    nn::os::SetThreadName(&sLogFlushThread, ThreadConfig::getName(NetThread::LogFlush));
+    nn::os::StartThread(&sLogFlushThread);
+
+    sIsLogFlushStarted = true;
+}
+
+void Logger::flushThreadFunc(void* arg) {
+    Logger* logger = (Logger*)arg;
+
+    while (true) {
+        ThreadConfig::updateCurrentThread(NetThread::LogFlush);
+
+        logger->flush();
+
+        if (sLogFileBufLen) {
+            u64 now = nn::os::GetSystemTick();
+            bool isIntervalPassed = now - sLogFileLastFlushTick >= cLogFileFlushIntervalSec * nn::os::GetSystemTickFrequency();
+
+            if (isIntervalPassed || sIsLogFileFlushRequested.exchange(false, std::memory_order_relaxed)) {
+                logger->flushLogFile();
+            }
+        }
+
+        nn::os::SleepThread(nn::TimeSpan::FromNanoSeconds(cLogFlushIntervalNs));
+    }
+}
+
+// sends every committed record in batches of up to cLogFlushBufSize bytes, stopping at the first record still being written
+void Logger::flush() {
+    u64 readPos = sLogReadPos.load(std::memory_order_relaxed);
+    u32 bufLen = 0;
+
+    u32 dropCount = sLogDropCount.load(std::memory_order_relaxed);
+    if (dropCount != sLogReportedDrops) {
+        if (LOG_BINARY) {
+            char msg[0x40];
+            u32 msgLen = nn::util::SNPrintf(msg, sizeof(msg), "Log ring full, dropped %u messages\n", dropCount - sLogReportedDrops);
+            bufLen = makeRecord(sLogFlushBuf, LogRecordType::Text, makeLevelCategory(LogLevel::Warn, LogCategory::General), 0, msg, msgLen);
         } else {
-            sInstance->socket_log(buf);
+            bufLen = nn::util::SNPrintf(sLogFlushBuf, cLogFlushBufSize, "[%s] Log ring full, dropped %u messages\n", sockName, dropCount - sLogReportedDrops);
         }
+        sLogReportedDrops = dropCount;
     }
 
-    va_end(args);
+    while (true) {
+        u32 len = __atomic_load_n((u32*)(sLogRing + readPos % cLogRingSize), __ATOMIC_ACQUIRE);
+
+        if (!len)
+            break;
+
+        if (bufLen + len > cLogFlushBufSize) {
+            writeOutput(sLogFlushBuf, bufLen);
+            bufLen = 0;
+        }
+
+        copyFromRing(sLogFlushBuf + bufLen, readPos + sizeof(u32), len);
+        bufLen += len;
+
+        u32 recordSize = calcRecordSize(len);
+        clearRing(readPos, recordSize);
+        readPos += recordSize;
+
+        sLogReadPos.store(readPos, std::memory_order_release);
+    }
+
+    if (bufLen)
+        writeOutput(sLogFlushBuf, bufLen);
+}
+
+void Logger::writeOutput(const char* data, u32 len) {
+    if (this->socket_log_state == SOCKET_LOG_CONNECTED) {
+        nn::socket::Send(this->socket_log_socket, data, len, 0);
+    } else if (LOG_SD_CARD && !sIsLogFileFailed) {
+        writeLogFile(data, len);
+    }
+}
+
+// moves the current log to cLogFilePrevPath and starts a new one, used at startup and for rotation
+bool Logger::openLogFile() {
+    if (sIsLogFileOpen) {
+        nn::fs::CloseFile(sLogFile);
+        sIsLogFileOpen = false;
+    } else if (nn::fs::MountSdCard(cLogFileMount).isFailure()) {
+        sIsLogFileFailed = true;
+        return false;
+    }
+
+    nn::fs::CreateDirectory(cLogFileDir);
+    nn::fs::DeleteFile(cLogFilePrevPath);
+    nn::fs::RenameFile(cLogFilePath, cLogFilePrevPath);
+
+    if (nn::fs::CreateFile(cLogFilePath, 0).isFailure() ||
+        nn::fs::OpenFile(&sLogFile, cLogFilePath, nn::fs::OpenMode_Write | nn::fs::OpenMode_Append).isFailure()) {
+        sIsLogFileFailed = true;
+        return false;
+    }
+
+    sIsLogFileOpen = true;
+    sLogFileOffset = 0;
+
+    #if LOG_BINARY
+    char handshake[sizeof(cLogBinaryMagic) + sizeof(u64) + sizeof(LogRecordHeader) + sizeof(sockName)];
+    u32 size = makeHandshake(handshake);
+    nn::fs::WriteFile(sLogFile, 0, handshake, size);
+    sLogFileOffset = size;
+    #endif
+
+    return true;
+}
+
+void Logger::writeLogFile(const char* data, u32 len) {
+    if (sLogFileBufLen + len > cLogFileBufSize) {
+        flushLogFile();
+    }
+
+    memcpy(sLogFileBuf + sLogFileBufLen, data, len);
+    sLogFileBufLen += len;
+}
+
+void Logger::flushLogFile() {
+    sLogFileLastFlushTick = nn::os::GetSystemTick();
+
+    if (!sLogFileBufLen || sIsLogFileFailed)
+        return;
+
+    if (!sIsLogFileOpen || sLogFileOffset + sLogFileBufLen > cLogFileMaxSize) {
+        if (!openLogFile()) {
+            sLogFileBufLen = 0;
+            return;
+        }
+    }
+
+    if (nn::fs::WriteFile(sLogFile, sLogFileOffset, sLogFileBuf, sLogFileBufLen, nn::fs::WriteOption(nn::fs::WriteOption::Flush)).isSuccess()) {
+        sLogFileOffset += sLogFileBufLen;
+    }
+
+    sLogFileBufLen = 0;
 }
 
 bool Logger::pingSocket() {
@@ -120,7 +500,5 @@ bool Logger::pingSocket() {
 
 void tryInitSocket() {
     __asm("STR X20, [X8,#0x18]");
-    #if DEBUGLOG
-    Logger::createInstance();  // creates a static instance for debug logger
-    #endif
+    Logger::createInstance();  // creates a static instance for debug logger, release builds only log to the SD card if LOG_SD_CARD is set
 }
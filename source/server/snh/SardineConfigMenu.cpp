@@ -33,10 +33,10 @@ bool SardineConfigMenu::updateMenu(int selectIndex)
 
     SardineInfo* curMode = GameModeManager::instance()->getInfo<SardineInfo>();
 
-    Logger::log("Setting Gravity Mode.\n");
+    LOG_INFO(Menu, "Setting Gravity Mode.\n");
 
     if (!curMode) {
-        Logger::log("Unable to Load Mode info!\n");
+        LOG_ERROR(Menu, "Unable to Load Mode info!\n");
         return true;
     }
 
@@ -78,7 +78,7 @@ bool SardineConfigMenu::updateMenu(int selectIndex)
         return true;
     }
     default:
-        Logger::log("Failed to interpret Index!\n");
+        LOG_ERROR(Menu, "Failed to interpret Index!\n");
         return false;
     }
 }
\ No newline at end of file
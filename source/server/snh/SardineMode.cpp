@@ -17,6 +17,7 @@
 #include "math/seadVector.h"
 #include "rs/util.hpp"
 #include "server/Client.hpp"
+#include "server/PuppetQuery.hpp"
 #include "server/gamemode/GameModeBase.hpp"
 #include "server/gamemode/GameModeFactory.hpp"
 #include "server/gamemode/GameModeManager.hpp"
@@ -44,14 +45,14 @@ void SardineMode::init(const GameModeInitInfo& info)
     sead::ScopedCurrentHeapSetter heapSetter(GameModeManager::instance()->getHeap());
 
     if (curGameInfo)
-        Logger::log("Gamemode info found: %s %s\n", GameModeFactory::getModeString(curGameInfo->mMode), GameModeFactory::getModeString(info.mMode));
+        LOG_INFO(GameMode, "Gamemode info found: %s %s\n", GameModeFactory::getModeString(curGameInfo->mMode), GameModeFactory::getModeString(info.mMode));
     else
-        Logger::log("No gamemode info found\n");
+        LOG_WARN(GameMode, "No gamemode info found\n");
     if (curGameInfo && curGameInfo->mMode == mMode) {
         sead::ScopedCurrentHeapSetter heapSetter(GameModeManager::getSceneHeap());
         mInfo = (SardineInfo*)curGameInfo;
         mModeTimer = new GameModeTimer(mInfo->mHidingTime);
-        Logger::log("Reinitialized timer with time %d:%.2d\n", mInfo->mHidingTime.mMinutes, mInfo->mHidingTime.mSeconds);
+        LOG_INFO(GameMode, "Reinitialized timer with time %d:%.2d\n", mInfo->mHidingTime.mMinutes, mInfo->mHidingTime.mSeconds);
     } else {
         if (curGameInfo)
             delete curGameInfo; // attempt to destory previous info before creating new one
@@ -176,14 +177,14 @@ void SardineMode::update()
             PuppetInfo* curInfo = Client::getPuppetInfo(i);
 
             if (!curInfo) {
-                Logger::log("Checking %d, hit bounds %d-%d\n", i, mPuppetHolder->getSize(), Client::getMaxPlayerCount());
+                LOG_TRACE(GameMode, "Checking %d, hit bounds %d-%d\n", i, mPuppetHolder->getSize(), Client::getMaxPlayerCount());
                 break;
             }
 
-            float pupDist = al::calcDistance(playerBase, curInfo->playerPos);
-            bool isPupInStage = al::isEqualString(curInfo->stageName, GameDataFunction::getCurrentStageName(mCurScene->mHolder));
+            const PuppetQueryResult& query = PuppetQuery::get(i);
+            float pupDist = query.dist;
 
-            if ((pupDist > highPuppetDistance || highPuppetDistance == -1) && isPupInStage && curInfo->isIt) {
+            if ((pupDist > highPuppetDistance || highPuppetDistance == -1) && query.isActive && curInfo->isIt) {
                 highPuppetDistance = pupDist;
                 farPuppetID = i;
             }
@@ -191,8 +192,8 @@ void SardineMode::update()
             if (curInfo->isIt)
                 isAnyIt = true;
 
-            if (curInfo->isConnected && curInfo->isInSameStage && curInfo->isIt && !mInfo->mIsIt && !isYukimaru && pupDist < 300.f) {
-                if (((PlayerActorHakoniwa*)playerBase)->mDimKeeper->is2DModel == curInfo->is2D && !PlayerFunction::isPlayerDeadStatus(playerBase)) {
+            if (query.isActive && curInfo->isIt && !mInfo->mIsIt && !isYukimaru && pupDist < 300.f) {
+                if (query.isSame2D && !PlayerFunction::isPlayerDeadStatus(playerBase)) {
                     mInfo->mIsIt = true;
                     mModeTimer->enableTimer();
                     mModeLayout->showPack();
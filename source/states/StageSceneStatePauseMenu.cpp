@@ -2,7 +2,7 @@
 
 void StageSceneStatePauseMenu::exeServerConfig(void) {
     if (al::isFirstStep(this)) {
-        Logger::log("Start Server Config Nerve.\n");
+        LOG_INFO(Menu, "Start Server Config Nerve.\n");
     }
 
     al::updateKitListPrev(mHost);
@@ -1,4 +1,5 @@
 #include "game/StageScene/StageSceneStateServerConfig.hpp"
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <math.h>
@@ -41,15 +42,16 @@ StageSceneStateServerConfig::StageSceneStateServerConfig(const char *name, al::S
 
     mMainOptionsList->unkInt1 = 1;
 
-    mMainOptionsList->initDataNoResetSelected(4);
+    mMainOptionsList->initDataNoResetSelected(5);
 
-    sead::SafeArray<sead::WFixedSafeString<0x200>, 4>* mainMenuOptions =
-        new sead::SafeArray<sead::WFixedSafeString<0x200>, 4>();
+    sead::SafeArray<sead::WFixedSafeString<0x200>, 5>* mainMenuOptions =
+        new sead::SafeArray<sead::WFixedSafeString<0x200>, 5>();
 
     mainMenuOptions->mBuffer[ServerConfigOption::GAMEMODECONFIG].copy(u"Gamemode Config");
     mainMenuOptions->mBuffer[ServerConfigOption::GAMEMODESWITCH].copy(u"Change Gamemode");
     mainMenuOptions->mBuffer[ServerConfigOption::SETIP].copy(u"Change Server IP");
     mainMenuOptions->mBuffer[ServerConfigOption::SETPORT].copy(u"Change Server Port");
+    mainMenuOptions->mBuffer[ServerConfigOption::THREADCONFIG].copy(u"Network Thread Config");
 
     mMainOptionsList->addStringData(mainMenuOptions->mBuffer, "TxtContent");
 
@@ -90,6 +92,15 @@ StageSceneStateServerConfig::StageSceneStateServerConfig(const char *name, al::S
 
     mModeSelectList->addStringData(modeSelectOptions->mBuffer, "TxtContent");
 
+    // network thread config menu
+
+    mThreadConfig = new SimpleLayoutMenu("ThreadConfigMenu", "OptionSelect", initInfo, 0, false);
+    mThreadConfigList = new CommonVerticalList(mThreadConfig, initInfo, true);
+
+    al::setPaneString(mThreadConfig, "TxtOption", u"Network Thread Config", 0);
+
+    mThreadConfigOptions = new sead::SafeArray<sead::WFixedSafeString<0x200>, cThreadConfigItemCount>();
+
     // gamemode config menu
     GameModeConfigMenuFactory factory("GameModeConfigFactory");
     for (int mode = 0; mode < factory.getMenuCount(); mode++) {
@@ -187,6 +198,10 @@ void StageSceneStateServerConfig::exeMainMenu() {
             al::setNerve(this, &nrvStageSceneStateServerConfigOpenKeyboardPort);
             break;
         }
+        case ServerConfigOption::THREADCONFIG: {
+            al::setNerve(this, &nrvStageSceneStateServerConfigThreadConfig);
+            break;
+        }
         default:
             kill();
             break;
@@ -267,12 +282,68 @@ void StageSceneStateServerConfig::exeGamemodeSelect() {
     subMenuUpdate();
 
     if (mIsDecideConfig && mCurrentList->isDecideEnd()) {
-        Logger::log("Setting Server Mode to: %d\n", mCurrentList->mCurSelected);
+        LOG_INFO(Menu, "Setting Server Mode to: %d\n", mCurrentList->mCurSelected);
         GameModeManager::instance()->setMode(static_cast<GameMode>(mCurrentList->mCurSelected));
         endSubMenu();
     }
 }
 
+void StageSceneStateServerConfig::exeThreadConfig() {
+    if (al::isFirstStep(this)) {
+
+        updateThreadConfigStrings();
+
+        mThreadConfigList->initDataNoResetSelected(cThreadConfigItemCount);
+        mThreadConfigList->addStringData(mThreadConfigOptions->mBuffer, "TxtContent");
+
+        mCurrentList = mThreadConfigList;
+        mCurrentMenu = mThreadConfig;
+
+        subMenuStart();
+    }
+
+    subMenuUpdate();
+
+    if (mIsDecideConfig && mCurrentList->isDecideEnd()) {
+        int selected = mCurrentList->mCurSelected;
+
+        if (selected < (int)NetThread::End * 2) {
+            NetThread thread = static_cast<NetThread>(selected / 2);
+
+            if (selected % 2 == 0) {
+                ThreadConfig::cyclePriority(thread);
+            } else {
+                ThreadConfig::cycleCoreMask(thread);
+            }
+        } else {
+            ThreadConfig::setMeasureCpuTime(!ThreadConfig::isMeasureCpuTime());
+        }
+
+        endSubMenu();
+    }
+}
+
+void StageSceneStateServerConfig::updateThreadConfigStrings() {
+    char value[0x20];
+    char entry[0x80];
+
+    for (int i = 0; i < (int)NetThread::End; i++) {
+        NetThread thread = static_cast<NetThread>(i);
+        const ThreadSettings& settings = ThreadConfig::getSettings(thread);
+
+        ThreadConfig::getPriorityString(value, sizeof(value), settings.priority);
+        int len = snprintf(entry, sizeof(entry), "%s Priority (%s)", ThreadConfig::getName(thread), value);
+        mThreadConfigOptions->mBuffer[i * 2].convertFromMultiByteString(entry, len);
+
+        ThreadConfig::getCoreMaskString(value, sizeof(value), settings.coreMask);
+        len = snprintf(entry, sizeof(entry), "%s Cores (%s)", ThreadConfig::getName(thread), value);
+        mThreadConfigOptions->mBuffer[i * 2 + 1].convertFromMultiByteString(entry, len);
+    }
+
+    mThreadConfigOptions->mBuffer[cThreadConfigItemCount - 1].copy(
+        ThreadConfig::isMeasureCpuTime() ? u"Measure Thread CPU Time (ON)" : u"Measure Thread CPU Time (OFF)");
+}
+
 void StageSceneStateServerConfig::exeSaveData() {
 
     if (al::isFirstStep(this)) {
@@ -346,5 +417,6 @@ NERVE_IMPL(StageSceneStateServerConfig, OpenKeyboardIP)
 NERVE_IMPL(StageSceneStateServerConfig, OpenKeyboardPort)
 NERVE_IMPL(StageSceneStateServerConfig, GamemodeConfig)
 NERVE_IMPL(StageSceneStateServerConfig, GamemodeSelect)
+NERVE_IMPL(StageSceneStateServerConfig, ThreadConfig)
 NERVE_IMPL(StageSceneStateServerConfig, SaveData)
 }
@@ -0,0 +1,261 @@
+// host benchmark for BatchMath.h: checks every kernel against the scalar sead path it replaces (Vector3f::length,
+// the al::lerpVec formula, QuatCalcCommon::slerpTo and per vector plane tests) for 32 puppets, then times both.
+// `make host_tests` also builds it against the NEON model in tests/neon, where only the checks are meaningful.
+// build and run with `make host_tests`
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "algorithms/BatchMath.h"
+#include "math/seadQuat.h"
+#include "math/seadQuatCalcCommon.h"
+#include "math/seadVector.h"
+
+static constexpr int cCount = 32;  // PuppetQuery::cMaxPuppets
+static constexpr int cIterations = 20000;
+
+static int sFailCount = 0;
+
+// keeps the compiler from dropping a benchmark loop whose results are never read
+template <typename T>
+static void keep(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+static void expect(bool condition, const char* what, double error) {
+    if (!condition) {
+        printf("failed: %s (error %g)\n", what, error);
+        sFailCount++;
+    }
+}
+
+template <typename Func>
+static double timeNs(Func func) {
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < cIterations; i++) {
+        func();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / cIterations;
+}
+
+struct Positions {
+    float x[cCount], y[cCount], z[cCount];
+    sead::Vector3f vecs[cCount];
+};
+
+struct Quats {
+    float x[cCount], y[cCount], z[cCount], w[cCount];
+    sead::Quatf quats[cCount];
+};
+
+static void fill(Positions& out, std::mt19937& rng) {
+    std::uniform_real_distribution<float> dist(-3000.f, 3000.f);
+
+    for (int i = 0; i < cCount; i++) {
+        out.vecs[i] = sead::Vector3f(dist(rng), dist(rng), dist(rng));
+        out.x[i] = out.vecs[i].x;
+        out.y[i] = out.vecs[i].y;
+        out.z[i] = out.vecs[i].z;
+    }
+}
+
+static void fill(Quats& out, std::mt19937& rng) {
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+
+    for (int i = 0; i < cCount; i++) {
+        sead::Quatf quat(dist(rng), dist(rng), dist(rng), dist(rng));
+        quat.normalize();
+
+        out.quats[i] = quat;
+        out.x[i] = quat.x;
+        out.y[i] = quat.y;
+        out.z[i] = quat.z;
+        out.w[i] = quat.w;
+    }
+}
+
+static void benchDistance(std::mt19937& rng) {
+    Positions positions;
+    fill(positions, rng);
+    sead::Vector3f target(12.f, -340.f, 56.f);
+
+    float distSq[cCount], dist[cCount];
+    batch::calcDistanceSq(distSq, positions.x, positions.y, positions.z, target, cCount);
+    batch::calcSqrt(dist, distSq, cCount);
+
+    double maxError = 0.0;
+    for (int i = 0; i < cCount; i++) {
+        float expected = (positions.vecs[i] - target).length();
+        maxError = fmax(maxError, fabs(dist[i] - expected) / expected);
+    }
+
+    expect(maxError < 1e-6, "distance matches Vector3f::length", maxError);
+
+    double batchNs = timeNs([&] {
+        batch::calcDistanceSq(distSq, positions.x, positions.y, positions.z, target, cCount);
+        batch::calcSqrt(dist, distSq, cCount);
+        keep(dist);
+    });
+
+    double scalarNs = timeNs([&] {
+        for (int i = 0; i < cCount; i++) {
+            dist[i] = (positions.vecs[i] - target).length();
+        }
+        keep(dist);
+    });
+
+    printf("distance: batch %.1f ns, sead %.1f ns (max rel error %g)\n", batchNs, scalarNs, maxError);
+}
+
+static void benchLerp(std::mt19937& rng) {
+    Positions start, targets, batchOut, scalarOut;
+    fill(start, rng);
+    fill(targets, rng);
+    constexpr float cRate = 0.25f;
+
+    batchOut = start;
+    batch::lerp(batchOut.x, batchOut.y, batchOut.z, targets.x, targets.y, targets.z, cRate, cCount);
+
+    double maxError = 0.0;
+    for (int i = 0; i < cCount; i++) {
+        sead::Vector3f expected = start.vecs[i] + (targets.vecs[i] - start.vecs[i]) * cRate;  // al::lerpVec
+        maxError = fmax(maxError, (sead::Vector3f(batchOut.x[i], batchOut.y[i], batchOut.z[i]) - expected).length());
+    }
+
+    expect(maxError < 1e-3, "lerp matches al::lerpVec", maxError);
+
+    double batchNs = timeNs([&] {
+        batchOut = start;
+        batch::lerp(batchOut.x, batchOut.y, batchOut.z, targets.x, targets.y, targets.z, cRate, cCount);
+        keep(batchOut);
+    });
+
+    double scalarNs = timeNs([&] {
+        scalarOut = start;
+        for (int i = 0; i < cCount; i++) {
+            scalarOut.vecs[i] += (targets.vecs[i] - scalarOut.vecs[i]) * cRate;
+        }
+        keep(scalarOut);
+    });
+
+    printf("lerp: batch %.1f ns, sead %.1f ns (max abs error %g)\n", batchNs, scalarNs, maxError);
+}
+
+static void benchSlerp(std::mt19937& rng) {
+    Quats start, targets, batchOut;
+    fill(start, rng);
+    fill(targets, rng);
+    constexpr float cRate = 0.3f;
+
+    // cover the nearly equal and opposite hemisphere branches too
+    targets.quats[3] = start.quats[3];
+    targets.x[3] = start.x[3], targets.y[3] = start.y[3], targets.z[3] = start.z[3], targets.w[3] = start.w[3];
+    targets.quats[5] = sead::Quatf(-start.w[5], -start.x[5], -start.y[5], -start.z[5]);  // sead takes w first
+    targets.x[5] = -start.x[5], targets.y[5] = -start.y[5], targets.z[5] = -start.z[5], targets.w[5] = -start.w[5];
+
+    batchOut = start;
+    batch::slerp(batchOut.x, batchOut.y, batchOut.z, batchOut.w, targets.x, targets.y, targets.z, targets.w, cRate, cCount);
+
+    // both represent the same rotation when |dot| is 1
+    double maxError = 0.0;
+    for (int i = 0; i < cCount; i++) {
+        sead::Quatf expected;
+        sead::QuatCalcCommon<float>::slerpTo(expected, start.quats[i], targets.quats[i], cRate);
+
+        float dot = expected.x * batchOut.x[i] + expected.y * batchOut.y[i] + expected.z * batchOut.z[i] + expected.w * batchOut.w[i];
+        maxError = fmax(maxError, fabs(1.0 - fabs(dot)));
+    }
+
+    expect(maxError < 1e-5, "slerp matches QuatCalcCommon::slerpTo", maxError);
+
+    sead::Quatf scalarOut[cCount];
+
+    double batchNs = timeNs([&] {
+        batchOut = start;
+        batch::slerp(batchOut.x, batchOut.y, batchOut.z, batchOut.w, targets.x, targets.y, targets.z, targets.w, cRate, cCount);
+        keep(batchOut);
+    });
+
+    double scalarNs = timeNs([&] {
+        for (int i = 0; i < cCount; i++) {
+            sead::QuatCalcCommon<float>::slerpTo(scalarOut[i], start.quats[i], targets.quats[i], cRate);
+        }
+        keep(scalarOut);
+    });
+
+    printf("slerp: batch %.1f ns, sead %.1f ns (max 1-|dot| %g)\n", batchNs, scalarNs, maxError);
+}
+
+static void benchFrustum(std::mt19937& rng) {
+    Positions positions;
+    fill(positions, rng);
+    constexpr float cRadius = 150.f;
+
+    // a box of half size 2000 around the origin, normals point inwards
+    const batch::Plane planes[batch::cFrustumPlaneCount] = {
+        {1.f, 0.f, 0.f, 2000.f}, {-1.f, 0.f, 0.f, 2000.f}, {0.f, 1.f, 0.f, 2000.f},
+        {0.f, -1.f, 0.f, 2000.f}, {0.f, 0.f, 1.f, 2000.f}, {0.f, 0.f, -1.f, 2000.f},
+    };
+
+    sead::Vector3f normals[batch::cFrustumPlaneCount];
+    for (int p = 0; p < batch::cFrustumPlaneCount; p++) {
+        normals[p] = sead::Vector3f(planes[p].x, planes[p].y, planes[p].z);
+    }
+
+    auto isInsideScalar = [&](const sead::Vector3f& pos) {
+        for (int p = 0; p < batch::cFrustumPlaneCount; p++) {
+            if (normals[p].dot(pos) + planes[p].d < -cRadius)
+                return false;
+        }
+        return true;
+    };
+
+    bool batchInside[cCount], scalarInside[cCount];
+    batch::isInFrustum(batchInside, positions.x, positions.y, positions.z, cRadius, planes, cCount);
+
+    int mismatchCount = 0, insideCount = 0;
+    for (int i = 0; i < cCount; i++) {
+        bool expected = isInsideScalar(positions.vecs[i]);
+        mismatchCount += batchInside[i] != expected;
+        insideCount += expected;
+    }
+
+    expect(mismatchCount == 0, "frustum matches the per vector plane test", mismatchCount);
+
+    double batchNs = timeNs([&] {
+        batch::isInFrustum(batchInside, positions.x, positions.y, positions.z, cRadius, planes, cCount);
+        keep(batchInside);
+    });
+
+    double scalarNs = timeNs([&] {
+        for (int i = 0; i < cCount; i++) {
+            scalarInside[i] = isInsideScalar(positions.vecs[i]);
+        }
+        keep(scalarInside);
+    });
+
+    printf("frustum: batch %.1f ns, sead %.1f ns (%d of %d inside)\n", batchNs, scalarNs, insideCount, cCount);
+}
+
+int main() {
+#ifdef __ARM_NEON
+    printf("BatchMathBench: NEON path (model), %d puppets\n", cCount);
+#else
+    printf("BatchMathBench: scalar path, %d puppets\n", cCount);
+#endif
+
+    std::mt19937 rng(1);
+
+    benchDistance(rng);
+    benchLerp(rng);
+    benchSlerp(rng);
+    benchFrustum(rng);
+
+    printf("%d failures\n", sFailCount);
+    return sFailCount != 0;
+}
@@ -0,0 +1,84 @@
+// host test for crc32::HashStr: the runtime path (slice by 8, or __crc32d/__crc32b when __ARM_FEATURE_CRC32 is defined)
+// has to match a plain bitwise crc for every length and alignment, including the tail bytes after the last full word.
+// `make host_tests` builds it twice, the second time against the instruction model in tests/acle.
+
+#include <cstdio>
+#include <random>
+#include <string_view>
+
+#include "algorithms/crc32.h"
+#include "algorithms/PlayerAnims.h"
+
+static_assert(crc32::HashStr("123456789") == 0xCBF43926);
+
+static uint32_t calcReference(std::string_view str) {
+    uint32_t crc = 0xffffffff;
+
+    for (char c : str) {
+        crc ^= (uint8_t)c;
+
+        for (int i = 0; i < 8; i++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1));
+        }
+    }
+
+    return crc ^ 0xffffffff;
+}
+
+static int sFailCount = 0;
+
+static void check(std::string_view str, const char* what) {
+    uint32_t expected = calcReference(str);
+    uint32_t actual = crc32::HashStr(str);
+
+    if (actual != expected) {
+        if (sFailCount < 10)
+            printf("%s: length %zu got %08X expected %08X\n", what, str.size(), actual, expected);
+        sFailCount++;
+    }
+}
+
+int main() {
+#ifdef __ARM_FEATURE_CRC32
+    printf("Crc32Test: crc32 instruction path\n");
+#else
+    printf("Crc32Test: slice by 8 path\n");
+#endif
+
+    check("123456789", "check value");
+
+    // every alignment against every length up to a few words, covers all tail sizes after the 8 byte loop
+    alignas(8) char buf[0x200];
+    std::mt19937 rng(1);
+
+    for (char& c : buf) {
+        c = (char)rng();
+    }
+
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t length = 0; length <= 64; length++) {
+            check(std::string_view(buf + offset, length), "unaligned");
+        }
+    }
+
+    for (int i = 0; i < 100000; i++) {
+        size_t length = rng() % 0x1F0;
+        size_t offset = rng() % (sizeof(buf) - length);
+        check(std::string_view(buf + offset, length), "random");
+    }
+
+    // the names the game actually hashes, and the compile time result for them
+    for (const char* name : PlayerAnims::s_Strs) {
+        check(name, "anim name");
+    }
+
+    constexpr uint32_t cWaitHash = crc32::HashStr("Wait");
+
+    if (cWaitHash != calcReference("Wait")) {
+        printf("constexpr and runtime hash differ\n");
+        sFailCount++;
+    }
+
+    printf("%d mismatches\n", sFailCount);
+    return sFailCount != 0;
+}
@@ -0,0 +1,99 @@
+// host benchmark for crc32::HashArray: compares the perfect hash lookup against the binary search over sorted crcs it
+// replaced, using the player anim names plus some misses. also fails if the two ever disagree on an index.
+// build and run with `make host_tests`
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "algorithms/PlayerAnims.h"
+
+// the previous lookup: crcs sorted next to their index, binary search for the hash then compare the string
+// keeps the compiler from dropping a benchmark loop whose results are never read
+template <typename T>
+static void keep(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+struct SortedHashes {
+    struct Entry {
+        uint32_t hash;
+        int64_t index;
+    };
+
+    std::vector<Entry> entries;
+
+    template <size_t Length>
+    explicit SortedHashes(const std::array<const char*, Length>& strings) {
+        for (size_t i = 0; i < Length; i++) {
+            entries.push_back({crc32::HashStr(strings[i]), (int64_t)i});
+        }
+
+        // stable so duplicate strings keep the lowest index, like HashArray
+        std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.hash < b.hash; });
+    }
+
+    int64_t findIndex(std::string_view str, const char* const* strings) const {
+        uint32_t hash = crc32::HashStr(str);
+        auto it = std::lower_bound(entries.begin(), entries.end(), hash, [](const Entry& entry, uint32_t value) { return entry.hash < value; });
+
+        if (it == entries.end() || it->hash != hash || std::string_view(strings[it->index]) != str)
+            return -1;
+
+        return it->index;
+    }
+};
+
+int main() {
+    const auto& strings = PlayerAnims::s_Strs;
+    SortedHashes sorted(strings);
+
+    std::vector<std::string> names(strings.begin(), strings.end());
+    for (int i = 0; i < 64; i++) {
+        names.push_back("Miss" + std::to_string(i));
+    }
+
+    std::vector<std::string_view> views(names.begin(), names.end());
+    int mismatchCount = 0;
+
+    for (std::string_view name : views) {
+        if (sorted.findIndex(name, strings.data()) != PlayerAnims::s_Hashes.FindIndex(name))
+            mismatchCount++;
+    }
+
+    printf("HashArrayBench: %zu names, %d mismatches\n", views.size(), mismatchCount);
+
+    constexpr int cIterations = 2000;
+    double lookupCount = (double)cIterations * views.size();
+
+    for (int run = 0; run < 3; run++) {
+        int64_t sink = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < cIterations; i++) {
+            for (std::string_view name : views) {
+                sink += sorted.findIndex(name, strings.data());
+                keep(sink);
+            }
+        }
+
+        auto mid = std::chrono::steady_clock::now();
+        for (int i = 0; i < cIterations; i++) {
+            for (std::string_view name : views) {
+                sink += PlayerAnims::s_Hashes.FindIndex(name);
+                keep(sink);
+            }
+        }
+
+        auto end = std::chrono::steady_clock::now();
+
+        printf("binary search %.1f ns/lookup, perfect hash %.1f ns/lookup\n",
+               std::chrono::duration<double, std::nano>(mid - start).count() / lookupCount,
+               std::chrono::duration<double, std::nano>(end - mid).count() / lookupCount);
+    }
+
+    return mismatchCount != 0;
+}
@@ -0,0 +1,96 @@
+// host test for PacketApplyQueue: packets keep their order, PLAYERINF/HACKCAPINF from a player that already has one
+// staged replace the staged payload in place, PLAYERDC stops that, and the list grows past its initial capacity.
+// build and run with `make host_tests`
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "server/PacketApplyQueue.hpp"
+
+static int sFailCount = 0;
+
+static void expect(bool condition, const char* what) {
+    if (!condition) {
+        printf("failed: %s\n", what);
+        sFailCount++;
+    }
+}
+
+// header followed by a u32 payload, allocated with malloc like SocketClient::recv does
+static Packet* makePacket(PacketType type, char user, u32 payload) {
+    Packet* packet = new (malloc(sizeof(Packet) + sizeof(u32))) Packet();
+    packet->mUserID.data[0] = user;
+    packet->mType = type;
+    packet->mPacketSize = sizeof(u32);
+    memcpy((u8*)packet + sizeof(Packet), &payload, sizeof(u32));
+    return packet;
+}
+
+static u32 getPayload(const Packet* packet) {
+    u32 payload;
+    memcpy(&payload, (const u8*)packet + sizeof(Packet), sizeof(u32));
+    return payload;
+}
+
+static void applyAll(PacketApplyQueue& queue) {
+    for (int i = 0; i < queue.getCount(); i++) {
+        free(queue.get(i));
+    }
+
+    queue.clear();
+}
+
+int main() {
+    PacketApplyQueue queue;
+
+    // coalescing keeps the first position and the latest payload
+    queue.push(makePacket(PacketType::PLAYERINF, 1, 1));
+    queue.push(makePacket(PacketType::PLAYERCON, 2, 2));
+    queue.push(makePacket(PacketType::PLAYERINF, 1, 3));
+    queue.push(makePacket(PacketType::HACKCAPINF, 1, 4));
+    queue.push(makePacket(PacketType::HACKCAPINF, 1, 5));
+    queue.push(makePacket(PacketType::PLAYERINF, 2, 6));
+
+    expect(queue.getCount() == 4, "movement packets are coalesced per player and type");
+    expect(queue.get(0)->mType == PacketType::PLAYERINF && getPayload(queue.get(0)) == 3, "PLAYERINF keeps its slot with the newest payload");
+    expect(queue.get(1)->mType == PacketType::PLAYERCON, "other packets keep their order");
+    expect(queue.get(2)->mType == PacketType::HACKCAPINF && getPayload(queue.get(2)) == 5, "HACKCAPINF keeps its slot with the newest payload");
+    expect(getPayload(queue.get(3)) == 6, "other players are not coalesced together");
+    expect(queue.getCoalesceCount() == 2, "coalesced packets are counted");
+
+    applyAll(queue);
+
+    // a disconnect splits the player's movement packets so nothing from after it is applied before it
+    queue.push(makePacket(PacketType::PLAYERINF, 1, 1));
+    queue.forgetPlayer(queue.get(0)->mUserID);
+    queue.push(makePacket(PacketType::PLAYERDC, 1, 2));
+    queue.push(makePacket(PacketType::PLAYERINF, 1, 3));
+
+    expect(queue.getCount() == 3, "PLAYERDC stops coalescing");
+    expect(getPayload(queue.get(0)) == 1 && getPayload(queue.get(2)) == 3, "state before the disconnect is untouched");
+
+    applyAll(queue);
+
+    // nothing is dropped when the game thread stops draining
+    constexpr int cPushCount = PacketApplyQueue::cInitialCapacity * 8 + 3;
+
+    for (int i = 0; i < cPushCount; i++) {
+        if (!queue.push(makePacket(PacketType::SHINECOLL, 1, i)))
+            expect(false, "push failed");
+    }
+
+    bool isOrdered = queue.getCount() == cPushCount;
+
+    for (int i = 0; i < queue.getCount() && isOrdered; i++) {
+        isOrdered = getPayload(queue.get(i)) == (u32)i;
+    }
+
+    expect(isOrdered, "queue grows past its initial capacity in order");
+
+    applyAll(queue);
+
+    printf("PacketApplyQueueTest: %d failures\n", sFailCount);
+    return sFailCount != 0;
+}
@@ -0,0 +1,360 @@
+// host benchmark for the PuppetInfo hot/cold split: walks 32 infos the way PuppetQuery::update, PuppetActor::control
+// and Client::syncPuppetInfos do, once with the layout and heap placement from before the split and once with the
+// current PuppetInfo in cache line aligned slots. the cache is flushed before every pass, since on the switch the
+// infos are usually evicted by the rest of the frame. also fails if the two layouts ever read different values.
+// build and run with `make host_tests`
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <set>
+#include <vector>
+
+#include "puppets/PuppetInfo.h"
+
+constexpr int cPuppetCount = 32;  // MAXPUPINDEX
+constexpr size_t cLineSize = 0x40;
+
+// PuppetInfo before the split, field order unchanged
+struct UnsplitPuppetInfo {
+    // General Puppet Info
+    char puppetName[0x10] = {};
+    bool isConnected = false;
+    nn::account::Uid playerID;
+    // Puppet Translation Info
+    sead::Vector3f playerPos = sead::Vector3f(0.f,0.f,0.f);
+    sead::Quatf playerRot = sead::Quatf(0.f,0.f,0.f,0.f);
+    // Puppet Stage Info
+    u8 scenarioNo = -1;
+    char stageName[0x40] = {};
+    bool isInSameStage = false;
+    // Puppet Costume Info
+    CostumeTypes::Type costumeBodyType = CostumeTypes::Type::Unknown;
+    CostumeTypes::Type costumeHeadType = CostumeTypes::Type::Unknown;
+    char costumeBody[0x20] = {};
+    char costumeHead[0x20] = {};
+    // Puppet Capture Info
+    char curHack[0x40] = {};
+    bool isCaptured = false;
+    bool isStartCapture = false;
+    // Puppet Model Info
+    PlayerAnims::Type curAnim = PlayerAnims::Type::Unknown;
+    PlayerAnims::Type curSubAnim = PlayerAnims::Type::Unknown;
+    char curAnimStr[PACKBUFSIZE] = {};
+    char curSubAnimStr[PACKBUFSIZE] = {};
+    float blendWeights[6] = {};
+    float animRate = 0.f;
+    bool is2D = false;
+    // Puppet Hack Cap Info
+    sead::Vector3f capPos = sead::Vector3f(0.f,0.f,0.f);
+    sead::Quatf capRot = sead::Quatf(0.f,0.f,0.f,0.f);
+    CapAnims::Type capAnim = CapAnims::Type::Unknown;
+    bool isCapThrow = false;
+    bool isHoldThrow = false;
+    // Hide and Seek Gamemode Info
+    bool isIt = false;
+    u8 seconds = 0;
+    u16 minutes = 0;
+    // Freeze Tag Gamemode Info
+    uint16_t freezeTagScore = 0;
+    bool isFreezeTagRunner = true;
+    bool isFreezeTagFreeze = false;
+    bool isFreezeTagFallenOff = false;
+    float freezeIconSize = 0.f;
+    // Network Sample
+    SeqLock<PuppetSample> netSample;
+    u32 netSampleSeq = 0;
+};
+
+// same as the slot in Client.cpp
+struct alignas(cLineSize) PuppetInfoSlot {
+    PuppetInfo info;
+};
+
+// keeps the compiler from dropping a benchmark loop whose results are never read
+template <typename T>
+static void keep(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// the old Client constructor made 32 separate `new PuppetInfo()` calls on its ExpHeap, which places the blocks one
+// after another behind a small block header, so mimic that instead of trusting the host malloc
+template <typename Info>
+struct Infos {
+    Info* infos[cPuppetCount];
+    void* block = nullptr;
+
+    ~Infos() {
+        for (Info* info : infos)
+            info->~Info();
+        free(block);
+    }
+};
+
+static void placeUnsplit(Infos<UnsplitPuppetInfo>& out) {
+    constexpr size_t cHeapHeaderSize = 0x10;
+    constexpr size_t cStride = (sizeof(UnsplitPuppetInfo) + cHeapHeaderSize + 7) & ~(size_t)7;
+
+    out.block = aligned_alloc(cLineSize, cStride * cPuppetCount + cLineSize);
+
+    for (int i = 0; i < cPuppetCount; i++)
+        out.infos[i] = new ((char*)out.block + cHeapHeaderSize + cStride * i) UnsplitPuppetInfo();
+}
+
+static void placeSplit(Infos<PuppetInfo>& out) {
+    out.block = aligned_alloc(cLineSize, sizeof(PuppetInfoSlot) * cPuppetCount);
+
+    PuppetInfoSlot* slots = (PuppetInfoSlot*)out.block;
+
+    for (int i = 0; i < cPuppetCount; i++)
+        out.infos[i] = &(new (&slots[i]) PuppetInfoSlot())->info;
+}
+
+// gives every puppet a different, deterministic state so the walks read real values
+template <typename Info>
+static void fill(Infos<Info>& infos) {
+    for (int i = 0; i < cPuppetCount; i++) {
+        Info* info = infos.infos[i];
+
+        info->isConnected = i % 5 != 0;
+        info->isInSameStage = i % 3 != 0;
+        info->is2D = i % 7 == 0;
+        info->isIt = i % 2 == 0;
+        info->isFreezeTagFreeze = i % 4 == 0;
+        info->playerPos = sead::Vector3f(i * 100.f, i * 3.f, -i * 50.f);
+        info->curAnim = (PlayerAnims::Type)(i % 20);
+        info->curSubAnim = (PlayerAnims::Type)(i % 11);
+        info->capAnim = (CapAnims::Type)(i % 5);
+        info->animRate = 1.f + i * 0.01f;
+        info->capPos = sead::Vector3f(i * 10.f, 20.f, i * 30.f);
+        info->capRot = sead::Quatf(1.f, 0.f, i * 0.01f, 0.f);
+
+        for (int w = 0; w < 6; w++)
+            info->blendWeights[w] = (i + w) * 0.1f;
+    }
+}
+
+// the network thread publishing one new sample per puppet, so the next sync pass copies every one
+template <typename Info>
+static void publish(Infos<Info>& infos, int frame) {
+    for (int i = 0; i < cPuppetCount; i++) {
+        PuppetSample& sample = infos.infos[i]->netSample.beginWrite();
+        sample.playerPos = sead::Vector3f(frame + i * 100.f, i * 3.f, -i * 50.f);
+        sample.curAnim = (PlayerAnims::Type)((frame + i) % 20);
+        sample.curSubAnim = (PlayerAnims::Type)(i % 11);
+        sample.capAnim = (CapAnims::Type)(i % 5);
+        snprintf(sample.stageName, sizeof(sample.stageName), "CapWorldHomeStage");
+        infos.infos[i]->netSample.endWrite();
+    }
+}
+
+// PuppetQuery::update gathering positions, plus the game mode and name tag checks over every puppet
+template <typename Info>
+static float walkQuery(const Infos<Info>& infos) {
+    float sum = 0.f;
+
+    for (int i = 0; i < cPuppetCount; i++) {
+        const Info* info = infos.infos[i];
+
+        if (info->isConnected && info->isInSameStage && !info->is2D) {
+            sum += info->playerPos.x + info->playerPos.y + info->playerPos.z;
+            sum += info->isIt + info->isFreezeTagFreeze;
+        }
+    }
+
+    return sum;
+}
+
+// the fields PuppetActor::control reads for each visible puppet
+template <typename Info>
+static float walkControl(const Infos<Info>& infos) {
+    float sum = 0.f;
+
+    for (int i = 0; i < cPuppetCount; i++) {
+        const Info* info = infos.infos[i];
+
+        sum += (int)info->curAnim + (int)info->curSubAnim + (int)info->capAnim + info->animRate;
+        sum += info->capPos.x + info->capRot.z + info->isCapThrow + info->isHoldThrow;
+
+        for (float weight : info->blendWeights)
+            sum += weight;
+    }
+
+    return sum;
+}
+
+// Client::syncPuppetInfos
+template <typename Info>
+static float walkSync(Infos<Info>& infos) {
+    float sum = 0.f;
+
+    for (int i = 0; i < cPuppetCount; i++) {
+        Info* curInfo = infos.infos[i];
+
+        PuppetSample sample;
+
+        if (!curInfo->netSample.tryRead(sample, curInfo->netSampleSeq))
+            continue;
+
+        curInfo->playerPos = sample.playerPos;
+        curInfo->playerRot = sample.playerRot;
+
+        curInfo->scenarioNo = sample.scenarioNo;
+        strcpy(curInfo->stageName, sample.stageName);
+
+        if (curInfo->curAnim != sample.curAnim || curInfo->curAnimStr[0] == '\0')
+            strcpy(curInfo->curAnimStr, sample.curAnim != PlayerAnims::Type::Unknown ? PlayerAnims::FindStr(sample.curAnim) : "Wait");
+
+        if (curInfo->curSubAnim != sample.curSubAnim)
+            strcpy(curInfo->curSubAnimStr, PlayerAnims::FindStr(sample.curSubAnim));
+
+        curInfo->curAnim = sample.curAnim;
+        curInfo->curSubAnim = sample.curSubAnim;
+        memcpy(curInfo->blendWeights, sample.blendWeights, sizeof(curInfo->blendWeights));
+        curInfo->is2D = sample.is2D;
+
+        curInfo->capPos = sample.capPos;
+        curInfo->capRot = sample.capRot;
+        curInfo->capAnim = sample.capAnim;
+        curInfo->isCapThrow = sample.isCapThrow;
+
+        curInfo->isCaptured = sample.isCaptured;
+        strcpy(curInfo->curHack, sample.curHack);
+
+        curInfo->costumeBodyType = sample.costumeBodyType;
+        curInfo->costumeHeadType = sample.costumeHeadType;
+        strcpy(curInfo->costumeBody, sample.costumeBody);
+        strcpy(curInfo->costumeHead, sample.costumeHead);
+
+        sum += curInfo->playerPos.x + (int)curInfo->curAnim;
+    }
+
+    return sum;
+}
+
+// distinct cache lines holding the given fields over all puppets
+template <typename Info>
+static size_t countLines(const Infos<Info>& infos, std::initializer_list<std::pair<size_t, size_t>> fields) {
+    std::set<uintptr_t> lines;
+
+    for (const Info* info : infos.infos) {
+        for (auto [offset, size] : fields) {
+            uintptr_t start = (uintptr_t)info + offset;
+            for (uintptr_t line = start / cLineSize; line <= (start + size - 1) / cLineSize; line++)
+                lines.insert(line);
+        }
+    }
+
+    return lines.size();
+}
+
+#define FIELD(type, name) std::pair<size_t, size_t>(offsetof(type, name), sizeof(type::name))
+
+template <typename Info>
+static size_t countQueryLines(const Infos<Info>& infos) {
+    return countLines(infos, {FIELD(Info, isConnected), FIELD(Info, isInSameStage), FIELD(Info, is2D), FIELD(Info, isIt),
+                              FIELD(Info, isFreezeTagFreeze), FIELD(Info, playerPos)});
+}
+
+template <typename Info>
+static size_t countControlLines(const Infos<Info>& infos) {
+    return countLines(infos, {FIELD(Info, curAnim), FIELD(Info, curSubAnim), FIELD(Info, capAnim), FIELD(Info, animRate),
+                              FIELD(Info, capPos), FIELD(Info, capRot), FIELD(Info, isCapThrow), FIELD(Info, isHoldThrow),
+                              FIELD(Info, blendWeights)});
+}
+
+// larger than any host last level cache we run on
+static std::vector<char> sFlushBuffer(32 * 1024 * 1024);
+
+static void flushCache() {
+    for (size_t i = 0; i < sFlushBuffer.size(); i += cLineSize)
+        sFlushBuffer[i]++;
+    keep(sFlushBuffer[0]);
+}
+
+struct Timings {
+    double query = 0, control = 0, sync = 0;
+};
+
+template <typename Info>
+static Timings timeWalks(Infos<Info>& infos, int passes, float& checksum) {
+    Timings timings;
+
+    for (int pass = 0; pass < passes; pass++) {
+        flushCache();
+        auto start = std::chrono::steady_clock::now();
+        float query = walkQuery(infos);
+        auto end = std::chrono::steady_clock::now();
+        timings.query += std::chrono::duration<double, std::nano>(end - start).count();
+
+        flushCache();
+        start = std::chrono::steady_clock::now();
+        float control = walkControl(infos);
+        end = std::chrono::steady_clock::now();
+        timings.control += std::chrono::duration<double, std::nano>(end - start).count();
+
+        publish(infos, pass);
+        flushCache();
+        start = std::chrono::steady_clock::now();
+        float sync = walkSync(infos);
+        end = std::chrono::steady_clock::now();
+        timings.sync += std::chrono::duration<double, std::nano>(end - start).count();
+
+        checksum += query + control + sync;
+        keep(checksum);
+    }
+
+    timings.query /= passes;
+    timings.control /= passes;
+    timings.sync /= passes;
+    return timings;
+}
+
+int main() {
+    Infos<UnsplitPuppetInfo> unsplit;
+    Infos<PuppetInfo> split;
+    placeUnsplit(unsplit);
+    placeSplit(split);
+    fill(unsplit);
+    fill(split);
+
+    int failCount = 0;
+
+    if (walkQuery(unsplit) != walkQuery(split) || walkControl(unsplit) != walkControl(split)) {
+        printf("FAIL: walks read different values from the two layouts\n");
+        failCount++;
+    }
+
+    for (int i = 0; i < cPuppetCount; i++) {
+        if ((uintptr_t)split.infos[i] % cLineSize != 0) {
+            printf("FAIL: split info %d is not cache line aligned\n", i);
+            failCount++;
+        }
+    }
+
+    printf("PuppetInfoBench: %d puppets, sizeof %zu unsplit, %zu split slot\n", cPuppetCount, sizeof(UnsplitPuppetInfo),
+           sizeof(PuppetInfoSlot));
+    printf("cache lines touched: query %zu -> %zu, control %zu -> %zu\n", countQueryLines(unsplit), countQueryLines(split),
+           countControlLines(unsplit), countControlLines(split));
+
+    constexpr int cPasses = 200;
+
+    for (int run = 0; run < 3; run++) {
+        float unsplitChecksum = 0.f, splitChecksum = 0.f;
+        Timings before = timeWalks(unsplit, cPasses, unsplitChecksum);
+        Timings after = timeWalks(split, cPasses, splitChecksum);
+
+        if (unsplitChecksum != splitChecksum) {
+            printf("FAIL: sync results differ between layouts\n");
+            failCount++;
+        }
+
+        printf("cold pass, unsplit -> split: query %.0f -> %.0f ns, control %.0f -> %.0f ns, sync %.0f -> %.0f ns\n",
+               before.query, after.query, before.control, after.control, before.sync, after.sync);
+    }
+
+    printf("%d failures\n", failCount);
+    return failCount != 0;
+}
@@ -0,0 +1,120 @@
+// host stress test for SeqLock: one thread publishes PuppetSamples as fast as it can while another reads them, every
+// field of a sample is derived from the same counter so a torn read shows up as a mismatch.
+// build and run with `make host_tests`
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include "puppets/PuppetInfo.h"
+
+static void fillSample(PuppetSample& sample, u32 n) {
+    float f = (float)n;
+    char c = 'a' + n % 26;
+
+    sample.playerPos = sead::Vector3f(f, f, f);
+    sample.playerRot = sead::Quatf(f, f, f, f);
+    sample.scenarioNo = n;
+    memset(sample.stageName, c, sizeof(sample.stageName) - 1);
+    sample.curAnim = (PlayerAnims::Type)(n % 900);
+    sample.curSubAnim = (PlayerAnims::Type)(n % 900);
+
+    for (float& weight : sample.blendWeights) {
+        weight = f;
+    }
+
+    sample.capPos = sead::Vector3f(f, f, f);
+    sample.capRot = sead::Quatf(f, f, f, f);
+    sample.isCaptured = n & 1;
+    memset(sample.curHack, c, sizeof(sample.curHack) - 1);
+    memset(sample.costumeBody, c, sizeof(sample.costumeBody) - 1);
+    memset(sample.costumeHead, c, sizeof(sample.costumeHead) - 1);
+}
+
+template <size_t Size>
+static bool isEqualArray(const char (&a)[Size], const char (&b)[Size]) {
+    return memcmp(a, b, Size) == 0;
+}
+
+// compares field by field, the padding between fields is never written and may hold anything
+static bool isConsistent(const PuppetSample& sample) {
+    PuppetSample expected;
+    fillSample(expected, (u32)sample.playerPos.x);
+
+    for (int i = 0; i < 6; i++) {
+        if (sample.blendWeights[i] != expected.blendWeights[i])
+            return false;
+    }
+
+    return sample.playerPos == expected.playerPos && sample.playerRot == expected.playerRot &&
+           sample.scenarioNo == expected.scenarioNo && isEqualArray(sample.stageName, expected.stageName) &&
+           sample.curAnim == expected.curAnim && sample.curSubAnim == expected.curSubAnim &&
+           sample.is2D == expected.is2D && sample.capPos == expected.capPos && sample.capRot == expected.capRot &&
+           sample.capAnim == expected.capAnim && sample.isCapThrow == expected.isCapThrow &&
+           sample.isCaptured == expected.isCaptured && isEqualArray(sample.curHack, expected.curHack) &&
+           sample.costumeBodyType == expected.costumeBodyType && sample.costumeHeadType == expected.costumeHeadType &&
+           isEqualArray(sample.costumeBody, expected.costumeBody) && isEqualArray(sample.costumeHead, expected.costumeHead);
+}
+
+int main() {
+    constexpr u32 cWriteCount = 200000;
+
+    static SeqLock<PuppetSample> lock;
+    std::atomic<bool> isDone = false;
+
+    std::thread writer([&] {
+        for (u32 n = 1; n <= cWriteCount; n++) {
+            PuppetSample& sample = lock.beginWrite();
+
+            // sleep in the middle of some writes and between others, so readers hit both even on a single core
+            sample.playerPos = sead::Vector3f((float)n, (float)n, (float)n);
+            if (n % 256 == 0)
+                std::this_thread::sleep_for(std::chrono::microseconds(10));
+
+            fillSample(sample, n);
+            lock.endWrite();
+
+            if (n % 256 == 128)
+                std::this_thread::sleep_for(std::chrono::microseconds(10));
+
+            // vary the gap between writes so reads land both inside and between them
+            for (u32 i = 0; i < n % 256; i++) {
+                asm volatile("");
+            }
+        }
+
+        isDone = true;
+    });
+
+    u32 lastSeq = 0;
+    u32 readCount = 0;
+    u32 tornCount = 0;
+    u32 lastValue = 0;
+    u32 backwardsCount = 0;
+
+    while (!isDone) {
+        PuppetSample sample;
+
+        if (!lock.tryRead(sample, lastSeq))
+            continue;
+
+        readCount++;
+
+        if (!isConsistent(sample))
+            tornCount++;
+
+        if ((u32)sample.playerPos.x < lastValue)
+            backwardsCount++;
+
+        lastValue = (u32)sample.playerPos.x;
+    }
+
+    writer.join();
+
+    printf("SeqLockTest: %u writes, %u reads, %u torn, %u out of order\n", cWriteCount, readCount, tornCount,
+           backwardsCount);
+
+    return tornCount == 0 && backwardsCount == 0 && readCount > 0 ? 0 : 1;
+}
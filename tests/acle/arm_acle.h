@@ -0,0 +1,24 @@
+// bitwise model of the AArch64 crc32 instructions so Crc32Test can exercise the __ARM_FEATURE_CRC32 path on the host.
+// reflected polynomial 0xEDB88320 without pre or post inversion, the same as CRC32B/CRC32X.
+
+#pragma once
+
+#include <stdint.h>
+
+inline uint32_t __crc32b(uint32_t crc, uint8_t data) {
+    crc ^= data;
+
+    for (int i = 0; i < 8; i++) {
+        crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1));
+    }
+
+    return crc;
+}
+
+inline uint32_t __crc32d(uint32_t crc, uint64_t data) {
+    for (int i = 0; i < 8; i++) {
+        crc = __crc32b(crc, (uint8_t)(data >> (i * 8)));
+    }
+
+    return crc;
+}
@@ -0,0 +1,40 @@
+// lane by lane model of the NEON intrinsics BatchMath.h uses, so BatchMathBench can check the __ARM_NEON path on the
+// host. only correctness means anything in this build, the timings are of the model.
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+struct float32x4_t {
+    float lanes[4];
+};
+
+struct uint32x4_t {
+    uint32_t lanes[4];
+};
+
+#define NEON_MODEL_MAP(type, expr) \
+    type result;                   \
+    for (int k = 0; k < 4; k++) {  \
+        result.lanes[k] = (expr);  \
+    }                              \
+    return result;
+
+inline float32x4_t vld1q_f32(const float* ptr) { NEON_MODEL_MAP(float32x4_t, ptr[k]) }
+inline void vst1q_f32(float* ptr, float32x4_t a) {
+    for (int k = 0; k < 4; k++) {
+        ptr[k] = a.lanes[k];
+    }
+}
+inline float32x4_t vdupq_n_f32(float value) { NEON_MODEL_MAP(float32x4_t, value) }
+inline float32x4_t vsubq_f32(float32x4_t a, float32x4_t b) { NEON_MODEL_MAP(float32x4_t, a.lanes[k] - b.lanes[k]) }
+inline float32x4_t vmulq_f32(float32x4_t a, float32x4_t b) { NEON_MODEL_MAP(float32x4_t, a.lanes[k] * b.lanes[k]) }
+inline float32x4_t vfmaq_f32(float32x4_t a, float32x4_t b, float32x4_t c) { NEON_MODEL_MAP(float32x4_t, fmaf(b.lanes[k], c.lanes[k], a.lanes[k])) }
+inline float32x4_t vfmaq_n_f32(float32x4_t a, float32x4_t b, float c) { NEON_MODEL_MAP(float32x4_t, fmaf(b.lanes[k], c, a.lanes[k])) }
+inline float32x4_t vsqrtq_f32(float32x4_t a) { NEON_MODEL_MAP(float32x4_t, sqrtf(a.lanes[k])) }
+inline uint32x4_t vdupq_n_u32(uint32_t value) { NEON_MODEL_MAP(uint32x4_t, value) }
+inline uint32x4_t vandq_u32(uint32x4_t a, uint32x4_t b) { NEON_MODEL_MAP(uint32x4_t, a.lanes[k] & b.lanes[k]) }
+inline uint32x4_t vcgeq_f32(float32x4_t a, float32x4_t b) { NEON_MODEL_MAP(uint32x4_t, a.lanes[k] >= b.lanes[k] ? 0xFFFFFFFFu : 0u) }
+
+#define vgetq_lane_u32(a, lane) ((a).lanes[lane])